@@ -0,0 +1,123 @@
+/* Instance generators for the benchmark suite
+ *
+ * Every instance is a function of its parameters and seed only: the generator draws from its
+ * own splitmix64 stream, so the suite is the same on every platform and compiler.
+ *
+ *   gen kcnf N M K SEED            random K-CNF with N variables and M clauses, in .cnf format
+ *   gen clique N DENSITY SEED      maximum clique of a random graph G(N, DENSITY): a hard
+ *                                  clause -u -v for every non-edge and a soft unit clause v
+ *                                  for every vertex, all unweighted, in .cnf format
+ *   gen wpms N M K SOFT SEED       weighted partial MaxSAT: M random hard K-clauses and SOFT
+ *                                  random soft 2-clauses of weights 1..10, in .wcnf format
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+unsigned long long state;
+
+unsigned long long draw()
+{
+	unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+	return z ^ (z>>31);
+}
+
+/* uniform in [0,n) */
+int below(int n)
+{
+	return (int) (((draw()>>32) * (unsigned long long) n) >> 32);
+}
+
+/* prints a clause of <k> distinct random variables with random signs */
+void printClause(int n, int k)
+{
+	vector<int> vars;
+	int i, j, v;
+	
+	while ((int) vars.size() < k)
+	{
+		v = below(n)+1;
+		for (j=0; j<(int) vars.size() && vars[j]!=v; j++);
+		if (j==(int) vars.size()) vars.push_back(v);
+	}
+	for (i=0; i<k; i++)
+		printf("%d ", below(2) ? vars[i] : -vars[i]);
+	printf("0\n");
+}
+
+void kcnf(int n, int m, int k)
+{
+	int c;
+	printf("c random %d-CNF\n", k);
+	printf("p cnf %d %d\n", n, m);
+	for (c=0; c<m; c++) printClause(n, k);
+}
+
+void clique(int n, double density)
+{
+	vector< pair<int,int> > nonEdges;
+	int u, v, i;
+	
+	for (u=1; u<=n; u++)
+		for (v=u+1; v<=n; v++)
+			if (draw()>>11 >= density*(1ULL<<53)) nonEdges.push_back(make_pair(u, v));
+	printf("c maximum clique of G(%d, %g)\n", n, density);
+	printf("p cnf %d %d\n", n, (int) nonEdges.size()+n);
+	for (i=0; i<(int) nonEdges.size(); i++)
+		printf("-%d -%d 0\n", nonEdges[i].first, nonEdges[i].second);
+	for (v=1; v<=n; v++)
+		printf("%d 0\n", v);
+}
+
+void wpms(int n, int m, int k, int soft)
+{
+	int top = 10*soft+1;
+	int c;
+	
+	printf("c weighted partial MaxSAT, random hard %d-clauses\n", k);
+	printf("p wcnf %d %d %d\n", n, m+soft, top);
+	for (c=0; c<m; c++)
+	{
+		printf("%d ", top);
+		printClause(n, k);
+	}
+	for (c=0; c<soft; c++)
+	{
+		printf("%d ", below(10)+1);
+		printClause(n, 2);
+	}
+}
+
+void usage()
+{
+	fprintf(stderr, "usage: gen kcnf N M K SEED | gen clique N DENSITY SEED | gen wpms N M K SOFT SEED\n");
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc<2) usage();
+	if (!strcmp(argv[1], "kcnf") && argc==6)
+	{
+		state = strtoull(argv[5], NULL, 10);
+		kcnf(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]));
+	}
+	else if (!strcmp(argv[1], "clique") && argc==5)
+	{
+		state = strtoull(argv[4], NULL, 10);
+		clique(atoi(argv[2]), atof(argv[3]));
+	}
+	else if (!strcmp(argv[1], "wpms") && argc==7)
+	{
+		state = strtoull(argv[6], NULL, 10);
+		wpms(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]), atoi(argv[5]));
+	}
+	else usage();
+	return 0;
+}
@@ -0,0 +1,65 @@
+/* Microbenchmarks for the CCLS kernels: init(), pick_var(), flip() and setBranchingAtom()
+ *
+ *   micro-ccls FILE [FIXED]
+ *
+ * The kernels run on one engine over the instance in FILE (bench/gen makes synthetic ones of
+ * a chosen size, clause length and variable degree), from a random assignment in which a
+ * FIXED fraction of the variables (0.25 by default) is immutable, as at a UCT node of that
+ * depth. init() and setBranchingAtom() rebuild the same state on every call; pick_var() picks
+ * from that state without flipping; flip() flips variables drawn beforehand.
+ */
+
+#define main uct_main
+#include "../ccls/main_uct.cpp"
+#undef main
+
+#include "perfcount.h"
+
+#define MB_FLIP_VARS 4096 // number of variables drawn for the flip() benchmark
+
+int main(int argc, char* argv[])
+{
+	double fixed = 0.25;
+	int v, numFixed, flipVars[MB_FLIP_VARS];
+	volatile int sink = 0;
+	
+	if (argc<2) {
+		printf("usage: micro-ccls FILE [FIXED]\n");
+		return 1;
+	}
+	if (argc>2) fixed = atof(argv[2]);
+	if (build_instance(argv[1])==0) {
+		printf("c Invalid filename: %s\n", argv[1]);
+		return 1;
+	}
+	build_neighbor_relation();
+	
+	Engine *engine = new Engine(1);
+	engine->configure(evaluator, C, prob, maxFlips);
+	for (v=1; v<=num_vars; v++) {
+		engine->best_soln[v] = engine->randomBelow(2);
+	}
+	engine->setMutable();
+	numFixed = (int) (fixed*num_vars);
+	for (v=1; v<=numFixed; v++) {
+		clear_bit(engine->varMutable, v);
+		engine->cur_soln[v] = engine->best_soln[v];
+	}
+	for (v=0; v<MB_FLIP_VARS; v++) {
+		flipVars[v] = numFixed+1 + engine->randomBelow(num_vars-numFixed);
+	}
+	
+	printf("Instance: %s, %d vars, %d clauses, %d fixed\n", argv[1], num_vars, num_clauses, numFixed);
+	MB_MEASURE("init", engine->init());
+	MB_MEASURE("setBranchingAtom", engine->setBranchingAtom(); sink += engine->nextBranchingAtom);
+	printf("Unsat clauses: %d\n", engine->unsat_stack_fill_pointer);
+	if (engine->unsat_stack_fill_pointer==0) {
+		printf("The assignment satisfies every clause, use a harder instance\n");
+		return 1;
+	}
+	MB_MEASURE("pick_var", sink += engine->pick_var());
+	MB_MEASURE("flip", engine->flip(flipVars[mb_i % MB_FLIP_VARS]));
+	
+	delete engine;
+	return 0;
+}
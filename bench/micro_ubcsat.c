@@ -0,0 +1,176 @@
+/* Microbenchmarks for the UBCSAT kernels of the UCT driver: setPreSat(), setBranchingAtom(),
+ * PickWalkSatUCT(), PickNoveltyUCT() and DefaultFlip(), and a check of concurrent SLS runs
+ *
+ *   micro-ubcsat FILE [FIXED] [THREADS]
+ *
+ * UBCSAT is set up as the driver sets it up for Novelty, with the break counts of WalkSAT built
+ * on top, over the instance in FILE (bench/gen makes synthetic ones of a chosen size, clause
+ * length and variable degree). The kernels start from a random assignment in which a FIXED fraction
+ * of the variables (0.25 by default) is immutable, as at a UCT node of that depth. The picks
+ * choose from that state without flipping; DefaultFlip() flips variables drawn beforehand.
+ *
+ * Then THREADS engines (4 by default) each set up a UBCSAT context of their own over the shared
+ * instance, with seeds of their own, and play MB_ENGINE_RUNS SLS runs with ubcsatrun(): first
+ * one engine at a time, then all at once. The engines are independent if both passes give the
+ * same results; the program fails otherwise.
+ */
+
+#include <pthread.h>
+
+#define main uct_main
+#include "../ubcsat/src/uct.c"
+#undef main
+
+#include "perfcount.h"
+
+#define MB_FLIP_VARS 4096 // number of variables drawn for the DefaultFlip() benchmark
+#define MB_ENGINE_RUNS 16 // SLS runs of each engine in the concurrency check
+#define MB_MAX_THREADS 64
+
+/* the kernels, from mylocal.c and ubcsat-triggers.c */
+void PickWalkSatUCT();
+void PickNoveltyUCT();
+void DefaultFlip();
+void CreateMakeBreak();
+void InitMakeBreakUCT();
+
+char *ubcargv[] = {"./ubcsat", "-alg", "novelty", "-v", "uct", "-runs", "1", "-cutoff", "1000",
+                   "-novnoise", "0.2", "-i", NULL, "-seed", "1", "-r", "stats", "null", "-r", "out", "null"};
+#define MB_SEED_ARG 14 // index of the seed in <ubcargv>
+double fixed = 0.25;
+
+/* An engine of the concurrency check: its seed, and the results of its SLS runs */
+typedef struct mbEngine {
+  int seed;
+  int results[MB_ENGINE_RUNS];
+} mbEngine;
+
+
+/* Thread body of an engine: sets up UBCSAT over the instance the main thread has read, then
+ * plays SLS runs from random assignments with the first <fixed> of the variables immutable */
+void *runEngine(void *arg) {
+  mbEngine *engine = (mbEngine *) arg;
+  char *argv[sizeof(ubcargv)/sizeof(ubcargv[0])];
+  char seed[16];
+  UINT32 j, numFixed = (UINT32) (fixed*iNumVars);
+  int r;
+  
+  memcpy(argv, ubcargv, sizeof(argv));
+  sprintf(seed, "%d", engine->seed);
+  argv[MB_SEED_ARG] = seed;
+  ubcsatsetup(sizeof(argv)/sizeof(argv[0]), argv);
+  
+  for (r=0; r<MB_ENGINE_RUNS; r++) {
+    setMutable();
+    for (j=1; j<=iNumVars; j++) {
+      bestSoln[j] = RandomInt(2);
+      if (j <= numFixed) SetImmutable(j);
+    }
+    setPreSat();
+    engine->results[r] = ubcsatrun();
+  }
+  FreeRAM();
+  return NULL;
+}
+
+
+/* Plays <n> engines one at a time, or all at once if <concurrent> is set, and returns the
+ * wall time they took */
+double runEngines(mbEngine *engines, int n, BOOL concurrent) {
+  pthread_t threads[MB_MAX_THREADS];
+  double start = mb_now();
+  int k;
+  
+  for (k=0; k<n; k++) {
+    pthread_create(&threads[k], NULL, runEngine, &engines[k]);
+    if (!concurrent) pthread_join(threads[k], NULL);
+  }
+  for (k=0; concurrent && k<n; k++) {
+    pthread_join(threads[k], NULL);
+  }
+  return mb_now() - start;
+}
+
+
+int main(int argc, char *argv[]) {
+  int ubcargc = sizeof(ubcargv)/sizeof(ubcargv[0]);
+  int k, numThreads = 4;
+  mbEngine alone[MB_MAX_THREADS], together[MB_MAX_THREADS];
+  double aloneTime, togetherTime;
+  UINT32 j, numFixed, flipVars[MB_FLIP_VARS];
+  volatile UINT32 sink = 0;
+  
+  if (argc < 2) {
+    printf("usage: micro-ubcsat FILE [FIXED] [THREADS]\n");
+    return 1;
+  }
+  if (argc > 2) fixed = atof(argv[2]);
+  if (argc > 3) numThreads = atoi(argv[3]);
+  if (numThreads < 1 || numThreads > MB_MAX_THREADS) {
+    printf("THREADS must be between 1 and %d\n", MB_MAX_THREADS);
+    return 1;
+  }
+  ubcargv[12] = argv[1];
+  ubcsatsetup(ubcargc, ubcargv);
+  if (iNumVars>MAX_NUM_VARS || iNumClauses>MAX_NUM_CLAUSES) {
+    printf("Fatal Error: increase size of MAX_NUM_VARS or MAX_NUM_CLAUSES\n");
+    return 1;
+  }
+  
+  setAlwaysSat();
+  setMutable();
+  numFixed = (UINT32) (fixed*iNumVars);
+  for (j=1; j<=iNumVars; j++) {
+    bestSoln[j] = RandomInt(2);
+    if (j <= numFixed) {
+      SetImmutable(j);
+      aVarValue[j] = bestSoln[j];
+    }
+  }
+  for (j=0; j<MB_FLIP_VARS; j++) {
+    flipVars[j] = numFixed+1 + RandomInt(iNumVars-numFixed);
+  }
+  
+  // the start of an SLS run, as in ubcsatrun()
+  iRun++;
+  iStep = 1;
+  RunProcedures(PreRun);
+  RunProcedures(PreInit);
+  RunProcedures(InitData);
+  RunProcedures(InitStateInfo);
+  RunProcedures(PostInit);
+  
+  printf("Instance: %s, %lu vars, %lu clauses, %lu fixed\n", argv[1], (unsigned long) iNumVars,
+         (unsigned long) iNumClauses, (unsigned long) numFixed);
+  MB_MEASURE("setPreSat", setPreSat());
+  MB_MEASURE("setBranchingAtom", setBranchingAtom(); sink += nextBranchingAtom);
+  printf("Unsat clauses: %lu\n", (unsigned long) iNumFalse);
+  if (iNumFalse == 0) {
+    printf("The assignment satisfies every clause, use a harder instance\n");
+    return 1;
+  }
+  // Novelty keeps no break counts, so build the ones PickWalkSatUCT() reads for this <preSat>
+  CreateMakeBreak();
+  InitMakeBreakUCT();
+  MB_MEASURE("PickWalkSatUCT", PickWalkSatUCT(); sink += iFlipCandidate);
+  MB_MEASURE("PickNoveltyUCT", PickNoveltyUCT(); sink += iFlipCandidate);
+  MB_MEASURE("DefaultFlip", iFlipCandidate = flipVars[mb_i % MB_FLIP_VARS]; DefaultFlip());
+  
+  // the same engines, one at a time and then concurrently
+  for (k=0; k<numThreads; k++) {
+    alone[k].seed = together[k].seed = k+2;
+  }
+  aloneTime = runEngines(alone, numThreads, FALSE);
+  togetherTime = runEngines(together, numThreads, TRUE);
+  printf("Concurrent ubcsatrun(): %d engines x %d runs, %.1f ms one at a time, %.1f ms at once (%.2fx)\n",
+         numThreads, MB_ENGINE_RUNS, 1000*aloneTime, 1000*togetherTime, aloneTime/togetherTime);
+  for (k=0; k<numThreads; k++) {
+    if (memcmp(alone[k].results, together[k].results, sizeof(alone[k].results))) {
+      printf("Engine %d found different results when run concurrently\n", k);
+      return 1;
+    }
+  }
+  printf("Every engine found the same results alone and concurrently\n");
+  
+  return 0;
+}
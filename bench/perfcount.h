@@ -0,0 +1,86 @@
+/* Timing and cache-miss counting for the microbenchmarks, shared by the C and C++ kernels
+ *
+ * Cache misses are read from a hardware counter through perf_event_open(2), for the calling
+ * thread only. Where the kernel does not allow it (perf_event_paranoid, containers, virtual
+ * machines without a PMU), mb_misses_stop() returns -1 and the benchmarks print n/a.
+ */
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MB_MIN_TIME 0.2 // seconds each kernel is timed for, at least
+
+static int mb_misses_fd = -2; // -2 before the first use, -1 if no counter is available
+
+static double mb_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void mb_misses_start(void)
+{
+	struct perf_event_attr attr;
+	
+	if (mb_misses_fd == -2)
+	{
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		mb_misses_fd = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		if (mb_misses_fd < 0) mb_misses_fd = -1;
+	}
+	if (mb_misses_fd >= 0)
+	{
+		ioctl(mb_misses_fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(mb_misses_fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+}
+
+/* cache misses since mb_misses_start(), or -1 */
+static long long mb_misses_stop(void)
+{
+	long long count;
+	
+	if (mb_misses_fd < 0) return -1;
+	ioctl(mb_misses_fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(mb_misses_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+	return count;
+}
+
+/* prints one result line: the kernel, its ns per call and cache misses per call */
+static void mb_report(const char *name, double seconds, long long ops, long long misses)
+{
+	char missStr[32];
+	
+	if (misses < 0) strcpy(missStr, "n/a");
+	else sprintf(missStr, "%.2f", misses/(double) ops);
+	printf("%-18s %12.1f ns/op %12s misses/op %12lld ops\n", name, 1e9*seconds/ops, missStr, ops);
+	fflush(stdout);
+}
+
+/* Times <op> in a loop, doubling the number of calls until the loop takes MB_MIN_TIME, and
+ * reports the last loop. <op> may use the loop counter mb_i. */
+#define MB_MEASURE(name, op) do { \
+	long long mb_n = 1, mb_i, mb_misses; \
+	double mb_time; \
+	for (;;) { \
+		mb_misses_start(); \
+		mb_time = mb_now(); \
+		for (mb_i = 0; mb_i < mb_n; mb_i++) { op; } \
+		mb_time = mb_now() - mb_time; \
+		mb_misses = mb_misses_stop(); \
+		if (mb_time >= MB_MIN_TIME) break; \
+		mb_n *= 2; \
+	} \
+	mb_report(name, mb_time, mb_n, mb_misses); \
+} while (0)
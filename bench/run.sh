@@ -0,0 +1,59 @@
+#!/bin/sh
+# usage: run.sh BUDGET RUNS INSTANCE...
+#
+# Runs both drivers (bin/uct-ccls and bin/uct-ubcsat, built with -DUCT_STATS) on every
+# instance for RUNS runs of BUDGET seconds each, and writes
+#   results/summary.csv  driver,instance,run,best_unsat,flips_per_sec,iterations_per_sec,evals_per_sec
+#   results/curves.csv   driver,instance,run,time,iteration,flips,best_unsat
+# best_unsat is the cost each driver reports: the unsat clause weight for CCLS, and for UBCSAT
+# the unsat clause weight on .wcnf instances (run with -w) and the number of unsat clauses on
+# .cnf ones. A driver that fails on an instance is reported on stderr and left out of the results.
+
+BUDGET=$1
+RUNS=$2
+shift 2
+
+mkdir -p results
+echo "driver,instance,run,best_unsat,flips_per_sec,iterations_per_sec,evals_per_sec" > results/summary.csv
+echo "driver,instance,run,time,iteration,flips,best_unsat" > results/curves.csv
+
+# parse DRIVER INSTANCE < driver output
+parse() {
+  awk -v driver="$1" -v inst="$2" -v runs="$RUNS" '
+    /^\*\*\* Best Num Unsat/ { section = "best"; next }
+    /^\*\*\* Anytime Profile/ { section = "profile"; next }
+    /^$/ { section = ""; next }
+    /^Stats run [0-9]+:/ { r = $3; sub(":", "", r); fps[r] = $4; ips[r] = $6; eps[r] = $8; next }
+    section == "best" && /^Run / { r = $2; sub(":", "", r); best[r] = $3; next }
+    section == "profile" && /^Run / {
+      r = $2; sub(":", "", r)
+      print driver "," inst "," r "," $3 "," $4 "," $6 "," $7 >> "results/curves.csv"
+    }
+    END {
+      for (r = 0; r < runs; r++)
+        print driver "," inst "," r "," best[r] "," fps[r] "," ips[r] "," eps[r] >> "results/summary.csv"
+    }'
+}
+
+for inst in "$@"; do
+  name=$(basename "$inst")
+  echo "$name"
+  
+  if bin/uct-ccls -f "$inst" -r "$RUNS" -t "$BUDGET" -y > results/ccls.out 2>&1; then
+    parse ccls "$name" < results/ccls.out
+  else
+    echo "ccls failed on $name" >&2
+  fi
+  
+  # the UBCSAT driver needs an iteration bound above what the budget allows, and -w for weights
+  case "$inst" in
+    *.wcnf) weights=-w ;;
+    *) weights= ;;
+  esac
+  if bin/uct-ubcsat -f "$inst" -r "$RUNS" -t "$BUDGET" -i 10000000 -s 1 -y $weights > results/ubcsat.out 2>&1; then
+    parse ubcsat "$name" < results/ubcsat.out
+  else
+    echo "ubcsat failed on $name" >&2
+  fi
+done
+rm -f results/ccls.out results/ubcsat.out
@@ -8,6 +8,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <time.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <climits>
+#include "hwcount.h"
 
 // branching factor
 #define BF 2
@@ -25,7 +33,8 @@
 #define MAX_VARS    10000010
 #define MAX_CLAUSES 43000043
 #define MAX_CLAUSE_LEN 20
-#define BIG_LONG 100000000
+#define NO_COST ULLONG_MAX	// cost of an engine, a run or a message without an assignment
+#define MAX_NEIGHBOR_ENTRIES 268435456	// above this many neighbor entries (1 GiB) they are not stored
 
 /* Data structure for UCT search -- maintained for each node in search tree */
 typedef struct uctnode {
@@ -38,56 +47,72 @@ typedef struct uctnode {
   struct uctnode** children; // node children
 } uctnode;
 
-double playNode(uctnode *node);
-short selectMove(uctnode *node);
-double estimateReward();
-int getNumUnsat(double reward);
-void setRootNode();
-void setBranchingAtom();
 uctnode *getNewNode(uctnode *parent, int armNum);
 void createChildren(uctnode *node);
 void freeNode(uctnode *node);
-int pick_var();
-int local_search();
-void select_prob_and_method();
-void setMutable();
-int runUCTtimed();
 void performRuns();
 void printParams();
 void printMemoryError();
-void  ALARMhandler(int sig);
+
+struct ws_task;
 void printUsageError();
 
 using namespace std;
 
-/* UCT data */
-short varMutable[MAX_VARS+1];
-short preSat[MAX_CLAUSES];
+/* Bitsets: entry i is bit (i&63) of word (i>>6), so a whole set is reset with a memset over
+ * n/64 words and scans can skip 64 entries at a time */
+typedef unsigned long long bitword;
+
+#define BITWORD_ONES		(~0ULL)
+#define bitset_words(n)		(((n)+63)>>6)
+#define get_bit(b,i)		(((b)[(i)>>6]>>((i)&63))&1ULL)
+#define set_bit(b,i)		((b)[(i)>>6] |= 1ULL<<((i)&63))
+#define clear_bit(b,i)		((b)[(i)>>6] &= ~(1ULL<<((i)&63)))
+#define set_all_bits(b,n)	memset((b), 0xFF, bitset_words(n)*sizeof(bitword))
+
+#define is_mutable(v)		get_bit(varMutable,v)
+#define is_presat(c)		get_bit(preSat,c)
 
 int depthLimit; // maximum depth a node may have
-short closedFlag = 0;
-int numPreFalsifiedClauses;
 
 
 #define pop(stack) stack[--stack ## _fill_pointer]
 #define push(item, stack) stack[stack ## _fill_pointer++] = item
 
-// Define a data structure for a literal in the SAT problem.
-struct lit {
-		int             clause_num;		//clause num, begin with 0
-     	int             var_num;		//variable num, begin with 1
-     	int             sense;			//is 1 for true literals, 0 for false literals.
-};
+// Literals are packed into 32 bits as var<<1|sense, where sense is 1 for true literals
+// and 0 for false literals. Variable occurrences are packed the same way as clause<<1|sense.
+typedef unsigned int lit;
+typedef unsigned int occ;
+
+#define make_lit(v,s)		(((lit)(v)<<1)|(lit)(s))
+#define lit_var(l)			((int)((l)>>1))
+#define lit_sense(l)		((int)((l)&1))
+#define make_occ(c,s)		(((occ)(c)<<1)|(occ)(s))
+#define occ_clause(o)		((int)((o)>>1))
+#define occ_sense(o)		((int)((o)&1))
 
 enum PROBLEMTYPE {NONE, WEIGHTED, UNWEIGHTED, WEIGHTED_PARTIAL};
 enum PROBLEMTYPE probtype;
 
+enum EVALUATOR {CCLS, WALKSAT, NOVELTY}; // SLS algorithms for leaf node value estimation
+
+int legacyRandom = 0; // whether engines draw from rand_r() with modulo reduction instead of xoshiro256**
+
+/* splitmix64: advances <state> and returns its next output, used to expand seeds */
+inline unsigned long long splitmix64(unsigned long long& state)
+{
+	unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+	return z ^ (z>>31);
+}
+
 
 /*parameters of the instance*/
 int     num_vars;		//var index from 1 to num_vars
 int     num_clauses;		//clause index from 0 to num_clauses-1
 
-int		hard_clause_weight;
+int		hard_clause_weight;	//top weight of a partial instance, clauses of at least this weight are hard
 
 int		maxi_clause_len;
 int		mini_clause_len;
@@ -95,102 +120,137 @@ int		maxi_clause_weight;
 int 	mini_clause_weight;
 const int diff_crafted_weight = 800;
 
-/* literal arrays */				
-lit*	var_lit[MAX_VARS];				//var_lit[i][j] means the j'th literal of var i.
+/* literal arrays, stored contiguously in CSR form */
+occ*	var_lit;						//occurrences of var v are var_lit[var_lit_start[v]..var_lit_start[v+1]-1]
+int*	var_lit_start;					//offset of each var's occurrences, num_vars+2 entries
 int		var_lit_count[MAX_VARS];			//amount of literals of each var
-lit*	clause_lit[MAX_CLAUSES];			//clause_lit[i][j] means the j'th literal of clause i.
+lit*	clause_lit;						//literals of clause c are clause_lit[clause_lit_start[c]..clause_lit_start[c+1]-1]
+int*	clause_lit_start;				//offset of each clause's literals, num_clauses+1 entries
 int		clause_lit_count[MAX_CLAUSES]; 			// amount of literals in each clause			
 int		clause_weight[MAX_CLAUSES];	
 			
 /* Information about the variables. */
-int		score[MAX_VARS];				
-int		conf_change[MAX_VARS];
-int*	var_neighbor[MAX_VARS];
-int		var_neighbor_count[MAX_VARS];
-int		neighbor_flag[MAX_VARS];
-
-/* Information about the clauses */					
-int     sat_count[MAX_CLAUSES];			
-int		sat_var[MAX_CLAUSES];			
-
-//unsat clauses stack
-int		unsat_stack[MAX_CLAUSES];		//store the unsat clause number
-int		unsat_stack_fill_pointer;
-int		index_in_unsat_stack[MAX_CLAUSES];//which position is a clause in the unsat_stack
-
-//variables in unsat clauses
-int		unsatvar_stack[MAX_VARS];		
-int		unsatvar_stack_fill_pointer;
-int		index_in_unsatvar_stack[MAX_VARS];
-int		unsat_app_count[MAX_VARS];		//a varible appears in how many unsat clauses
-
-
-/* Information about solution */
-int     cur_soln[MAX_VARS];	//the current solution, with 1's for True variables, and 0's for False variables
-int		best_soln[MAX_VARS];
+int*	var_neighbor;					//neighbors of var v are var_neighbor[var_neighbor_start[v]..var_neighbor_start[v+1]-1]
+long long*	var_neighbor_start;			//offset of each var's neighbors, num_vars+2 entries
+int		neighbor_lazy = 0;				//if set, the neighbors are not stored and flip() walks the clauses instead
 
 //cutoff steps
 const unsigned long long max_tries = 9223372036854775806ll;
 const unsigned long long max_flips = 9223372036854775806ll;
-unsigned long long total_unsat_clause_weight=0ll;
 unsigned long long total_clause_weight=0ll;
+unsigned long long total_soft_weight=0ll;	//weight of the clauses that are not hard
 double opt_time;
 unsigned long long opt_unsat_clause_weight;
 int is_opt_unsat_clause_weight_first_assigned;
 int opt_unsat_clause_count;
 
 
+/* whether a clause of weight <weight> is hard; the top weight of a partial instance exceeds
+ * the total soft weight, so an assignment is feasible iff its cost is below it */
+inline int is_hard(int weight)
+{
+	return probtype==WEIGHTED_PARTIAL && weight>=hard_clause_weight;
+}
+
+
 int temp_lit[MAX_VARS];
-int temp_neighbor[MAX_VARS];
-int temp_neighbor_count;
+vector<lit> lit_buffer;	//literals of the clauses read so far, in clause order
 ifstream infile;
 
 void build_instance_weighted();
 void build_instance_unweighted();
+void build_literal_arrays();
 
-/* NOTE: place call correctly */
-void build_neighbor_relation()
+/* Counts the neighbors of variables first..last-1 into var_neighbor_start[v+1], or with
+ * <fill> set stores them at var_neighbor_start[v]. Each worker has its own flags. */
+void neighbor_worker(int first, int last, int fill)
 {
 	int		i,j,count;
-	int 	v,c;
+	int 	v,c,u;
+	vector<char> flag(num_vars+1, 0);
+	int*	np;
 
-	/* for UCT */
-	depthLimit = num_vars-1;
-
-	for(v=1; v<=num_vars; ++v)
+	for(v=first; v<last; ++v)
 	{
-		var_neighbor_count[v] = 0;
-		neighbor_flag[v] = 1;
-		temp_neighbor_count = 0;
-		for(i=0; i<var_lit_count[v]; ++i)
+		count = 0;
+		np = fill ? var_neighbor+var_neighbor_start[v] : NULL;
+		flag[v] = 1;
+		for(i=var_lit_start[v]; i<var_lit_start[v+1]; ++i)
 		{
-			c = var_lit[v][i].clause_num;
-			for(j=0; j<clause_lit_count[c]; ++j)
+			c = occ_clause(var_lit[i]);
+			for(j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
 			{
-				if(neighbor_flag[clause_lit[c][j].var_num]==0)
+				u = lit_var(clause_lit[j]);
+				if(flag[u]==0)
 				{
-					var_neighbor_count[v]++;
-					neighbor_flag[clause_lit[c][j].var_num] = 1;
-					temp_neighbor[temp_neighbor_count++] = clause_lit[c][j].var_num;
+					flag[u] = 1;
+					if(fill) np[count] = u;
+					count++;
 				}
 			}
-			
 		}
 
-		neighbor_flag[v] = 0;
- 
-		var_neighbor[v] = new int[var_neighbor_count[v]+1];
-
-		count = 0;
-		for(i=0; i<temp_neighbor_count; i++)
+		// clear only the flags that were set
+		flag[v] = 0;
+		for(i=var_lit_start[v]; i<var_lit_start[v+1]; ++i)
 		{
-			var_neighbor[v][count++] = temp_neighbor[i];
-			neighbor_flag[temp_neighbor[i]] = 0;
+			c = occ_clause(var_lit[i]);
+			for(j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
+				flag[lit_var(clause_lit[j])] = 0;
 		}
 
-		var_neighbor[v][count]=0;
-		var_neighbor_count[v] = count;
+		if(!fill) var_neighbor_start[v+1] = count;
+	}
+}
+
+/* Runs neighbor_worker() over all variables, split into ranges of about equal numbers of
+ * occurrences, one per hardware thread */
+void run_neighbor_workers(int fill)
+{
+	int		t,v,num_threads;
+	int		total = var_lit_start[num_vars+1];
+	vector<thread> workers;
+
+	num_threads = thread::hardware_concurrency();
+	if (num_threads < 1) num_threads = 1;
+	if (num_threads > total/65536+1) num_threads = total/65536+1;
+
+	v = 1;
+	for(t=1; t<=num_threads; ++t)
+	{
+		int first = v;
+		while(v<=num_vars && (t==num_threads || var_lit_start[v] < (long long)total*t/num_threads)) ++v;
+		workers.push_back(thread(neighbor_worker, first, v, fill));
+	}
+	for(t=0; t<num_threads; ++t) workers[t].join();
+}
+
+/* Builds the neighbor relation once for the loaded instance. If it would have more than
+ * MAX_NEIGHBOR_ENTRIES entries it is left implicit (<neighbor_lazy>). */
+void build_neighbor_relation()
+{
+	int v;
+
+	/* for UCT */
+	depthLimit = num_vars-1;
+
+	var_neighbor_start = new long long[num_vars+2];
+	var_neighbor_start[0] = var_neighbor_start[1] = 0;
+	run_neighbor_workers(0);
+	for(v=1; v<=num_vars; ++v)
+		var_neighbor_start[v+1] += var_neighbor_start[v];
+
+	if(var_neighbor_start[num_vars+1] > MAX_NEIGHBOR_ENTRIES)
+	{
+		printf("c %lld neighbor entries, computing neighbors on the fly\n", var_neighbor_start[num_vars+1]);
+		fflush(stdout);
+		delete[] var_neighbor_start;
+		neighbor_lazy = 1;
+		return;
 	}
+
+	var_neighbor = new int[var_neighbor_start[num_vars+1]];
+	run_neighbor_workers(1);
 }
 
 
@@ -199,7 +259,7 @@ int build_instance(char *filename)
 	
 	string line, tempstr1, tempstr2;
 	const char* c_line;
-	int             i,v,c;
+	int             v,c;
 	string		check_is_partial;
 	
 	infile.open(filename);
@@ -242,37 +302,69 @@ int build_instance(char *filename)
 	mini_clause_weight = -1;
 	//Now, read the clauses, one at a time.
 	
-	if(check_is_partial.compare("")==0)
+	if(check_is_partial.compare("")!=0)
 	{
-		if(strcmp(tempstr2.c_str(),"wcnf")==0)
-			build_instance_weighted();
-		else build_instance_unweighted();
+		long long top = atoll(check_is_partial.c_str());
+		if(top<=0 || top>INT_MAX)
+		{
+			printf("c the top weight %s is out of the range of clause weights.\n", check_is_partial.c_str());
+			fflush(stdout);
+			exit(-1);
+		}
+		probtype = WEIGHTED_PARTIAL;
+		hard_clause_weight = (int)top;
 	}
+	if(strcmp(tempstr2.c_str(),"wcnf")==0)
+		build_instance_weighted();
+	else build_instance_unweighted();
 	
 	infile.close();
 	
+	build_literal_arrays();
+	
+	return 1;
+		
+}
+
+/* builds the CSR clause and var literal arrays from <lit_buffer> and <clause_lit_count> */
+void build_literal_arrays()
+{
+	int             i,v,c;
+	
+	//creat clause literal arrays from the literals read in, in clause order
+	clause_lit_start = new int[num_clauses+1];
+	clause_lit_start[0] = 0;
+	for (c = 0; c < num_clauses; ++c)
+		clause_lit_start[c+1] = clause_lit_start[c]+clause_lit_count[c];
+	clause_lit = new lit[clause_lit_start[num_clauses]+1];
+	for (i = 0; i < clause_lit_start[num_clauses]; ++i)
+		clause_lit[i] = lit_buffer[i];
+	vector<lit>().swap(lit_buffer);
+	
 	//creat var literal arrays
+	for (v=1; v<=num_vars; ++v)
+		var_lit_count[v] = 0;
+	for (i = 0; i < clause_lit_start[num_clauses]; ++i)
+		var_lit_count[lit_var(clause_lit[i])]++;
+	var_lit_start = new int[num_vars+2];
+	var_lit_start[1] = 0;
 	for (v=1; v<=num_vars; ++v)
 	{
-		var_lit[v] = new lit[var_lit_count[v]+1];
-		var_lit[v][var_lit_count[v]].var_num = 0;
-		var_lit[v][var_lit_count[v]].clause_num=-1;
+		var_lit_start[v+1] = var_lit_start[v]+var_lit_count[v];
 		var_lit_count[v] = 0;	//reset to 0, for build up the array
 	}
+	var_lit = new occ[var_lit_start[num_vars+1]+1];
 	//scan all clauses to build up var literal arrays
 	/* NOTE: data structures created here */
 	for (c = 0; c < num_clauses; ++c) 
 	{
-		for(i=0; i<clause_lit_count[c]; ++i)
+		for(i=clause_lit_start[c]; i<clause_lit_start[c+1]; ++i)
 		{
-			v = clause_lit[c][i].var_num;
-			var_lit[v][var_lit_count[v]] = clause_lit[c][i];
+			v = lit_var(clause_lit[i]);
+			var_lit[var_lit_start[v]+var_lit_count[v]] = make_occ(c,lit_sense(clause_lit[i]));
 			++var_lit_count[v];
 		}
 	}
-	
-	return 1;
-		
 }
 
 void build_instance_weighted()
@@ -282,14 +374,14 @@ void build_instance_weighted()
 	
 	int lit_redundent,clause_redundent;
 	
-	probtype = WEIGHTED;
+	if(probtype!=WEIGHTED_PARTIAL)
+		probtype = WEIGHTED;
 	
 	for (c = 0; c < num_clauses; ) 
 	{
 		clause_redundent=0;
 		
 		infile>>clause_weight[c];
-		total_clause_weight+=(unsigned long long)clause_weight[c];
 		infile>>cur_lit;
 		while (cur_lit != 0) { 
 		
@@ -318,19 +410,13 @@ void build_instance_weighted()
 		
 		if(clause_redundent==0)
 		{
-			clause_lit[c] = new lit[clause_lit_count[c]+1];
-		
+			total_clause_weight+=(unsigned long long)clause_weight[c];
+			if(!is_hard(clause_weight[c]))
+				total_soft_weight+=(unsigned long long)clause_weight[c];
 			for(i=0; i<clause_lit_count[c]; ++i)
 			{
-				clause_lit[c][i].clause_num = c;
-				clause_lit[c][i].var_num = abs(temp_lit[i]);
-				if (temp_lit[i] > 0) clause_lit[c][i].sense = 1;
-					else clause_lit[c][i].sense = 0;
-			
-				var_lit_count[clause_lit[c][i].var_num]++;
+				lit_buffer.push_back(make_lit(abs(temp_lit[i]), temp_lit[i]>0));
 			}
-			clause_lit[c][clause_lit_count[c]].var_num=0;
-			clause_lit[c][clause_lit_count[c]].clause_num=-1;
 			
 			maxi_clause_len = maxi_clause_len>clause_lit_count[c]?maxi_clause_len:clause_lit_count[c];
 			mini_clause_len = mini_clause_len<clause_lit_count[c]?mini_clause_len:clause_lit_count[c];
@@ -366,7 +452,6 @@ void build_instance_unweighted()
 		clause_redundent=0;
 		
 		clause_weight[c] = 1;
-		total_clause_weight+=(unsigned long long)clause_weight[c];
 		infile>>cur_lit;
 		while (cur_lit != 0) { 
 		
@@ -395,19 +480,13 @@ void build_instance_unweighted()
 		
 		if(clause_redundent==0)
 		{
-			clause_lit[c] = new lit[clause_lit_count[c]+1];
-		
+			total_clause_weight+=(unsigned long long)clause_weight[c];
+			if(!is_hard(clause_weight[c]))
+				total_soft_weight+=(unsigned long long)clause_weight[c];
 			for(i=0; i<clause_lit_count[c]; ++i)
 			{
-				clause_lit[c][i].clause_num = c;
-				clause_lit[c][i].var_num = abs(temp_lit[i]);
-				if (temp_lit[i] > 0) clause_lit[c][i].sense = 1;
-					else clause_lit[c][i].sense = 0;
-			
-				var_lit_count[clause_lit[c][i].var_num]++;
+				lit_buffer.push_back(make_lit(abs(temp_lit[i]), temp_lit[i]>0));
 			}
-			clause_lit[c][clause_lit_count[c]].var_num=0;
-			clause_lit[c][clause_lit_count[c]].clause_num=-1;
 			
 			maxi_clause_len = maxi_clause_len>clause_lit_count[c]?maxi_clause_len:clause_lit_count[c];
 			mini_clause_len = mini_clause_len<clause_lit_count[c]?mini_clause_len:clause_lit_count[c];
@@ -429,45 +508,444 @@ void build_instance_unweighted()
 }
 
 
+/* The best assignment found by any engine in a run. The cost is a single atomic word, so
+ * engines can test it on every exchange for free; the assignment is guarded by a seqlock.
+ * Writers publish only strict improvements and serialize on the odd sequence number,
+ * readers copy the assignment and retry if the sequence number moved meanwhile, so a
+ * reader never waits on a lock and never sees a mix of two assignments. */
+class Incumbent
+{
+public:
+	atomic<unsigned long long>	cost;
+	atomic<unsigned int>		sequence;	// odd while a writer is copying its assignment
+	atomic<int>*				soln;
+
+	Incumbent() {
+		soln = new atomic<int>[num_vars+1];
+		reset();
+	}
+	~Incumbent() {
+		delete[] soln;
+	}
+
+	void reset() {
+		cost.store(NO_COST);
+		sequence.store(0);
+	}
+
+	/* Publishes <newSoln> if <newCost> beats the incumbent, returns whether it did */
+	bool publish(unsigned long long newCost, const int *newSoln) {
+		int v;
+		unsigned int seq;
+
+		do {
+			if (newCost >= cost.load(memory_order_relaxed)) return false;
+			seq = sequence.load(memory_order_relaxed);
+		} while ((seq&1) || !sequence.compare_exchange_weak(seq, seq+1, memory_order_acquire));
+		atomic_thread_fence(memory_order_release);
+
+		// another writer may have published a better assignment before we got the lock
+		if (newCost >= cost.load(memory_order_relaxed)) {
+			sequence.store(seq, memory_order_release);
+			return false;
+		}
+		for (v=1; v<=num_vars; v++)
+			soln[v].store(newSoln[v], memory_order_relaxed);
+		cost.store(newCost, memory_order_relaxed);
+		sequence.store(seq+2, memory_order_release);
+		return true;
+	}
+
+	/* Copies a consistent snapshot of the incumbent into <outSoln> and its cost into
+	 * <outCost>; gives up and returns false if a writer got in the way */
+	bool snapshot(unsigned long long &outCost, int *outSoln) {
+		int v;
+		unsigned int seq = sequence.load(memory_order_acquire);
+
+		if (seq&1) return false;
+		for (v=1; v<=num_vars; v++)
+			outSoln[v] = soln[v].load(memory_order_relaxed);
+		outCost = cost.load(memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		return sequence.load(memory_order_relaxed) == seq;
+	}
+};
+
+
+/* A run deadline on the monotonic wall clock, or on the CPU clock of the whole process. Setting
+ * one is thread-safe to check from every engine; each check costs a clock_gettime() call, so the
+ * flip loops only check every few hundred flips. */
+class Deadline
+{
+public:
+	int		cpu;		// whether <at> is in process CPU time rather than wall time
+	double	at;			// expiry time in seconds on the chosen clock, 0 if there is no deadline
+
+	Deadline() : cpu(0), at(0.0) {}
+
+	static double now(int cpu) {
+		struct timespec ts;
+		clock_gettime(cpu ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec + ts.tv_nsec*1e-9;
+	}
+
+	void set(double seconds, int useCpu) {
+		cpu = useCpu;
+		at = now(cpu) + seconds;
+	}
+
+	void clear() {
+		at = 0.0;
+	}
+
+	bool expired() {
+		return at>0.0 && now(cpu)>=at;
+	}
+};
+
+
+/* An improvement of an engine's best assignment, for the anytime profile of a run */
+struct trajectoryPoint
+{
+	double				time;		// wall time since the start of the run, in seconds
+	unsigned long long	iteration;	// UCT iteration of the engine
+	unsigned long long	nodes;		// size of the engine's UCT trees
+	unsigned long long	flips;		// flips of the engine in the run
+	unsigned long long	cost;		// unsat clause weight of the new best assignment
+};
+
+
+/* Hot-path counters of the UCT loop. They are only updated in builds with -DUCT_STATS, through
+ * STATS(), so the default build carries no timing calls. Times are in seconds; the descent is
+ * the part of the iteration time spent outside of leaf evaluations. */
+#ifdef UCT_STATS
+#define STATS(...) __VA_ARGS__
+#else
+#define STATS(...)
+#endif
+
+struct uctStats
+{
+	unsigned long long	evaluations;	// leaf evaluations, one SLS run each
+	unsigned long long	leafDepth;		// sum of the depths of the evaluated leaves
+	unsigned long long	closedArms;
+	double				initTime;		// init(), which also rebuilds the preSat clauses
+	double				slsTime;		// local_search()
+	double				branchTime;		// setBranchingAtom()
+	double				iterationTime;	// whole UCT iterations
+	unsigned long long	hw[HW_PHASES][HW_EVENTS];	// hardware counts of each phase, with -x
+	int					hwEvents;		// bit e is set if some engine counted event e
+
+	uctStats() { memset(this, 0, sizeof(*this)); }
+
+	void add(const uctStats& other) {
+		evaluations += other.evaluations;
+		leafDepth += other.leafDepth;
+		closedArms += other.closedArms;
+		initTime += other.initTime;
+		slsTime += other.slsTime;
+		branchTime += other.branchTime;
+		iterationTime += other.iterationTime;
+		for (int p=0; p<HW_PHASES; ++p)
+			for (int e=0; e<HW_EVENTS; ++e)
+				hw[p][e] += other.hw[p][e];
+		hwEvents |= other.hwEvents;
+	}
+};
+
+/* bytes held by the UCT trees of all engines, and their peak since the last reset */
+atomic<long long> treeBytes(0);
+atomic<long long> peakTreeBytes(0);
+
+inline void countTreeBytes(long long bytes)
+{
+	long long now = treeBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+	long long peak = peakTreeBytes.load(memory_order_relaxed);
+	while (now > peak && !peakTreeBytes.compare_exchange_weak(peak, now, memory_order_relaxed));
+}
+
+
+/* Reusable barrier for a fixed number of threads, used to cut deterministic runs into epochs */
+class EpochBarrier
+{
+public:
+	mutex				lock;
+	condition_variable	released;
+	int					threads;
+	int					waiting;
+	unsigned long long	generation;
+
+	EpochBarrier(int n) : threads(n), waiting(0), generation(0) {}
+
+	void wait() {
+		unique_lock<mutex> guard(lock);
+		unsigned long long g = generation;
+		if (++waiting == threads) {
+			waiting = 0;
+			generation++;
+			released.notify_all();
+		}
+		else {
+			while (g == generation) released.wait(guard);
+		}
+	}
+};
+
+
+/* A UCT search with CCLS playouts. Everything above is the instance, which is read-only
+ * once it is loaded; the search state lives in an Engine, so several engines can search
+ * the same formula concurrently, one per thread. */
+class Engine
+{
+public:
+	/* Information about the variables. */
+	int*	score;
+	int*	conf_change;
+
+	/* Information about the clauses */
+	int*	sat_count;
+	int*	sat_var;
+
+	//unsat clauses stack
+	int*	unsat_stack;				//store the unsat clause number
+	int		unsat_stack_fill_pointer;
+	int*	index_in_unsat_stack;		//which position is a clause in the unsat_stack
+
+	int*	unsat_app_count;			//a varible appears in how many unsat clauses
+
+	//configuration changed variables in unsat clauses, the candidates of the greedy step of pick_var
+	int*	ccd_stack;
+	int		ccd_stack_fill_pointer;
+	int*	index_in_ccd_stack;
+
+	/* Information about solution */
+	int*	cur_soln;	//the current solution, with 1's for True variables, and 0's for False variables
+	int*	best_soln;
+	unsigned long long total_unsat_clause_weight;
+	unsigned long long preFalsifiedWeight;	// weight of the clauses falsified by immutable variables
+
+	int*	best_array;
+	int		best_array_count;
+	unsigned long long step;
+	long long* time_stamp;		// step at which each var was last flipped, -1 if it was not
+
+	/* UCT data */
+	bitword* varMutable;
+	bitword* preSat;			// bits past the last clause are always set
+	short	closedFlag;
+	short	infeasibleFlag;		// set by init() if the immutable variables falsify a hard clause
+	uctnode* root;				// root node of the UCT search tree
+	int		nextBranchingAtom;	// the next atom to branch on given the current formula
+	unsigned long long bestNumUnsat;
+	int*	varScores;			// used in setBranchingAtom
+	int*	bestVars;			// used in setBranchingAtom
+
+	/* cube of a cooperative worker: cubeAtoms[i] is fixed to bit i of <cube> */
+	const int* cubeAtoms;
+	int		cubeSize;
+	int		cube;
+	unsigned int task;			// id of the work-stealing task being searched, 0 otherwise
+
+	unsigned int seed;			// rand_r() state, one stream per engine
+	unsigned long long xs[4];	// xoshiro256** state, expanded from the same seed
+	int		id;					// index of the engine in its run
+
+	/* anytime profile of the current run */
+	unsigned long long	iterations;
+	unsigned long long	nodes;
+	unsigned long long	flips;
+	int					maxDepth;	// depth of the deepest leaf played
+	vector<trajectoryPoint>	trajectory;
+	uctStats	stats;
+	double		nextStatsReport;	// time of the next periodic report of <stats>
+	hw_group	hw;					// hardware counters of the engine's thread, with -x
+
+	/* the current iteration, for the trace of -z */
+	vector<unsigned int>	tracePath;	// atom<<1|arm of each node above the leaf
+	unsigned int	traceLeaf;			// atom of the leaf
+	unsigned int	traceClosed;		// bit a is set if arm a of the leaf is closed
+	double			traceReward[BF];
+	unsigned long long	traceCost;		// lowest cost the SLS runs of the iteration reached
+	unsigned long long	traceFlips;		// <flips> at the end of the previous iteration
+	vector<char>	traceBuffer;
+
+	/* configuration */
+	int		evaluator;			// SLS algorithm used for leaf node value estimation
+	double	C;					// exploration bias parameter for UCT
+	int		prob;				// noise parameter, out of RAND_MAX_INT
+	int		maxFlips;			// number of flips in each SLS run
+
+	Engine(unsigned int rand_seed);
+	~Engine();
+	void configure(int alg, double c, int noise, int flips);
+
+	int rng() { return rand_r(&seed); }
+
+	/* xoshiro256**, upper 32 bits */
+	unsigned int next() {
+		unsigned long long r = xs[1]*5;
+		r = ((r<<7) | (r>>57)) * 9;
+		unsigned long long t = xs[1]<<17;
+		xs[2] ^= xs[0];
+		xs[3] ^= xs[1];
+		xs[1] ^= xs[2];
+		xs[0] ^= xs[3];
+		xs[2] ^= t;
+		xs[3] = (xs[3]<<45) | (xs[3]>>19);
+		return (unsigned int) (r>>32);
+	}
+
+	/* uniform in [0,n) for n>0, by Lemire's multiply-shift: the rejection loop removes the
+	 * bias and only runs, with its division, when the low product word falls below n */
+	int randomBelow(int n) {
+		if (legacyRandom) return rng()%n;
+		unsigned long long m = (unsigned long long) next() * (unsigned int) n;
+		if ((unsigned int) m < (unsigned int) n) {
+			unsigned int threshold = (0u - (unsigned int) n) % (unsigned int) n;
+			while ((unsigned int) m < threshold)
+				m = (unsigned long long) next() * (unsigned int) n;
+		}
+		return (int) (m>>32);
+	}
+
+	// CCLS, in basic_uct.h
+	void init();
+	void flip(int flipvar);
+	inline void unsat(int clause);
+	inline void sat(int clause);
+	inline void ccd_add(int v);
+	inline void ccd_remove(int v);
+
+	// UCT and the CCLS search loop, in main_uct.cpp
+	double playNode(uctnode *node);
+	short selectMove(uctnode *node);
+	double estimateReward();
+	double leafReward(unsigned long long cost);
+	void setRootNode();
+	void setBranchingAtom();
+	int pick_var();
+	int pick_var_walksat();
+	int pick_var_novelty();
+	int break_weight(int v);
+	unsigned long long local_search();
+	void setMutable();
+	void shareIncumbent();
+	void reportToCoordinator();
+	void exchangeEpoch();
+	void startTrajectory();
+	void recordImprovement();
+	void reportStats();
+	void traceIteration();
+	void hwSample(int phase) { if (hw.size) hw.sample(stats.hw[phase]); }
+	unsigned long long runUCTtimed();
+	unsigned long long bestCost();
+	int runTask(ws_task *task, int iterations);
+};
+
+Engine::Engine(unsigned int rand_seed)
+{
+	score = new int[num_vars+1];
+	conf_change = new int[num_vars+1];
+	sat_count = new int[num_clauses];
+	sat_var = new int[num_clauses];
+	unsat_stack = new int[num_clauses];
+	index_in_unsat_stack = new int[num_clauses];
+	ccd_stack = new int[num_vars+1];
+	index_in_ccd_stack = new int[num_vars+1];
+	unsat_app_count = new int[num_vars+1];
+	cur_soln = new int[num_vars+1];
+	best_soln = new int[num_vars+1];
+	best_array = new int[num_vars+1];
+	time_stamp = new long long[num_vars+1];
+	varMutable = new bitword[bitset_words(num_vars+1)];
+	preSat = new bitword[bitset_words(num_clauses)];
+	varScores = new int[num_vars+1];
+	bestVars = new int[num_vars+1];
+
+	memset(cur_soln, 0, (num_vars+1)*sizeof(int));
+	memset(best_soln, 0, (num_vars+1)*sizeof(int));
+	closedFlag = 0;
+	infeasibleFlag = 0;
+	root = NULL;
+	cubeAtoms = NULL;
+	cubeSize = 0;
+	cube = 0;
+	task = 0;
+	id = 0;
+	iterations = nodes = flips = 0;
+	maxDepth = 0;
+	seed = rand_seed;
+	unsigned long long state = rand_seed;
+	for (int i=0; i<4; ++i) xs[i] = splitmix64(state);
+}
+
+void Engine::configure(int alg, double c, int noise, int flips)
+{
+	evaluator = alg;
+	C = c;
+	prob = noise;
+	maxFlips = flips;
+}
+
+Engine::~Engine()
+{
+	delete[] score;
+	delete[] conf_change;
+	delete[] sat_count;
+	delete[] sat_var;
+	delete[] unsat_stack;
+	delete[] index_in_unsat_stack;
+	delete[] ccd_stack;
+	delete[] index_in_ccd_stack;
+	delete[] unsat_app_count;
+	delete[] cur_soln;
+	delete[] best_soln;
+	delete[] best_array;
+	delete[] time_stamp;
+	delete[] varMutable;
+	delete[] preSat;
+	delete[] varScores;
+	delete[] bestVars;
+}
+
 void free_memory()
 {
-	int i;
-	for (i = 0; i < num_clauses; i++) 
-		delete[] clause_lit[i];
+	delete[] clause_lit;
+	delete[] clause_lit_start;
+	delete[] var_lit;
+	delete[] var_lit_start;
 	
-	for(i=1; i<=num_vars; ++i)
+	if(!neighbor_lazy)
 	{
-		delete[] var_lit[i];
-		delete[] var_neighbor[i];
+		delete[] var_neighbor;
+		delete[] var_neighbor_start;
 	}
 }
 
 
-inline void unsat(int clause)
+inline void Engine::unsat(int clause)
 {
 	int v;
 	index_in_unsat_stack[clause] = unsat_stack_fill_pointer;
 	push(clause,unsat_stack);
 	
 	total_unsat_clause_weight += (unsigned long long)clause_weight[clause];
-	lit * p = clause_lit[clause];
+	lit * p = clause_lit+clause_lit_start[clause];
+	lit * pe = clause_lit+clause_lit_start[clause+1];
 
-	for(;(v=p->var_num)!=0; p++)
+	for(; p<pe; p++)
 	{
-		if (!varMutable[v]) continue;
+		v = lit_var(*p);
+		if (!is_mutable(v)) continue;
 		unsat_app_count[v]++;
-		if(unsat_app_count[v]==1)
-		{
-			index_in_unsatvar_stack[v] = unsatvar_stack_fill_pointer;
-			push(v,unsatvar_stack);	
-		}
+		if(unsat_app_count[v]==1 && conf_change[v]) ccd_add(v);
 	}
 }
 
 
-inline void sat(int clause)
+inline void Engine::sat(int clause)
 {
-	int index,last_unsat_clause,v,last_unsat_var;
+	int index,last_unsat_clause,v;
 
 	//the clause is satisfied so its position can be reused to store the last_unsat_clause
 	last_unsat_clause = pop(unsat_stack);
@@ -476,25 +954,38 @@ inline void sat(int clause)
 	index_in_unsat_stack[last_unsat_clause] = index;
 	
 	total_unsat_clause_weight -= (unsigned long long)clause_weight[clause];
-	lit * p = clause_lit[clause];
+	lit * p = clause_lit+clause_lit_start[clause];
+	lit * pe = clause_lit+clause_lit_start[clause+1];
 	
-	for(;(v=p->var_num)!=0; p++)
+	for(; p<pe; p++)
 	{
-		if (!varMutable[v]) continue;
+		v = lit_var(*p);
+		if (!is_mutable(v)) continue;
 		unsat_app_count[v]--;
-		if(unsat_app_count[v]==0)
-		{
-			last_unsat_var = pop(unsatvar_stack);
-			index = index_in_unsatvar_stack[v];
-			unsatvar_stack[index] = last_unsat_var;
-			index_in_unsatvar_stack[last_unsat_var] = index;
-		}
+		if(unsat_app_count[v]==0 && conf_change[v]) ccd_remove(v);
 	}
 }
 
 
+/* <ccd_stack> holds exactly the variables with conf_change set and unsat_app_count above
+ * zero; unsat(), sat() and flip() keep it so on every change of either */
+inline void Engine::ccd_add(int v)
+{
+	index_in_ccd_stack[v] = ccd_stack_fill_pointer;
+	push(v,ccd_stack);
+}
+
+inline void Engine::ccd_remove(int v)
+{
+	int last_ccd_var = pop(ccd_stack);
+	int index = index_in_ccd_stack[v];
+	ccd_stack[index] = last_ccd_var;
+	index_in_ccd_stack[last_ccd_var] = index;
+}
+
+
 /* initialization before each UCT run */
-void init()
+void Engine::init()
 {
 	int 		v,c;
 	int			i,j;
@@ -502,20 +993,24 @@ void init()
 	
 	//init unsat_stack
 	unsat_stack_fill_pointer = 0;
-	unsatvar_stack_fill_pointer = 0;
+	ccd_stack_fill_pointer = 0;
 	total_unsat_clause_weight = 0ll;
 	
-	numPreFalsifiedClauses = 0;
+	preFalsifiedWeight = 0;
+	infeasibleFlag = 0;
 
 	//init solution
+	//immutable variables are in no unsat clause as far as <ccd_stack> is concerned
 	for (v = 1; v <= num_vars; v++) {
-		if (!varMutable[v]) continue; 
+		unsat_app_count[v]=0;
+		if (!is_mutable(v)) continue; 
 		cur_soln[v] = best_soln[v];
 		conf_change[v] = 1;
-		unsat_app_count[v]=0;
+		time_stamp[v] = -1;
 	}
 
 	closedFlag = 1;
+	set_all_bits(preSat, num_clauses);
 
 	// figure out sat_count, and init unsat_stack
 	for (c=0; c<num_clauses; ++c) 
@@ -524,20 +1019,21 @@ void init()
 		clausePresat = 1;
         preFalsified = 1;
         
-		for(j=0; j<clause_lit_count[c]; ++j)
+		for(j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
 		{
-			if (varMutable[clause_lit[c][j].var_num]) {
+			v = lit_var(clause_lit[j]);
+			if (is_mutable(v)) {
 				preFalsified = 0;
 				clausePresat = 0;
-				if (cur_soln[clause_lit[c][j].var_num] == clause_lit[c][j].sense)
+				if (cur_soln[v] == lit_sense(clause_lit[j]))
 				{
 					sat_count[c]++;
-					sat_var[c] = clause_lit[c][j].var_num;	
+					sat_var[c] = v;	
 				}
 			}
-			else if (clause_lit[c][j].sense) {
+			else if (cur_soln[v] == lit_sense(clause_lit[j])) {
 				sat_count[c]=1;
-				sat_var[c] = clause_lit[c][j].var_num;
+				sat_var[c] = v;
             	clausePresat = 1;
         		preFalsified = 0;
         		break;
@@ -547,16 +1043,16 @@ void init()
 		
         if (clausePresat) 
         {
-      	 	preSat[c] = 1;
       	 	if (preFalsified)
       	 	{
-      	 		numPreFalsifiedClauses++;
+      	 		preFalsifiedWeight += clause_weight[c];
+      	 		if (is_hard(clause_weight[c])) infeasibleFlag = 1;
       	 	}
 
     	}
     	else 
     	{
-    		preSat[c] = 0;
+    		clear_bit(preSat,c);
       		closedFlag = 0;
     		if (sat_count[c] == 0) 
 			{
@@ -568,21 +1064,18 @@ void init()
 	}
 
 	// figure out variable dscore
-	int lit_count;
 	for (v=1; v<=num_vars; v++) 
 	{
 		
 		score[v] = 0;
-		if (!varMutable[v]) continue;
-		
-		lit_count = var_lit_count[v];
+		if (!is_mutable(v)) continue;
 		
-		for(i=0; i<lit_count; ++i)
+		for(i=var_lit_start[v]; i<var_lit_start[v+1]; ++i)
 		{
-			c = var_lit[v][i].clause_num;
-			if (preSat[c]) continue;
+			c = occ_clause(var_lit[i]);
+			if (is_presat(c)) continue;
 			if (sat_count[c]==0) score[v]+=clause_weight[c];
-			else if (sat_count[c]==1 && var_lit[v][i].sense==cur_soln[v]) score[v]-=clause_weight[c];
+			else if (sat_count[c]==1 && occ_sense(var_lit[i])==cur_soln[v]) score[v]-=clause_weight[c];
 		}
 	}
 	
@@ -594,21 +1087,25 @@ void init()
 
  
 //flip a var, and do the neccessary updating
-void flip(int flipvar)
+void Engine::flip(int flipvar)
 {
 	int v,c;
 	lit* clause_c;
+	lit* clause_e;
 	lit* p;
-	lit* q;
+	occ* q;
+	occ* qe;
 
 	cur_soln[flipvar] = 1 - cur_soln[flipvar];
 	
 	//update related clauses and neighbor vars
-	for(q=var_lit[flipvar]; (c=q->clause_num)!=-1; q++)
+	for(q=var_lit+var_lit_start[flipvar], qe=var_lit+var_lit_start[flipvar+1]; q<qe; q++)
 	{
-		if (preSat[c]) continue;
-		clause_c = clause_lit[c];
-		if(cur_soln[flipvar] == q->sense)
+		c = occ_clause(*q);
+		if (is_presat(c)) continue;
+		clause_c = clause_lit+clause_lit_start[c];
+		clause_e = clause_lit+clause_lit_start[c+1];
+		if(cur_soln[flipvar] == occ_sense(*q))
 		{
 			++sat_count[c];
 			
@@ -621,9 +1118,9 @@ void flip(int flipvar)
 				sat_var[c] = flipvar;//record the only true lit's var
 				score[flipvar]-=clause_weight[c];
 				
-				for(p=clause_c; (v=p->var_num)!=0; p++)
+				for(p=clause_c; p<clause_e; p++)
 				{
-					score[v]-=clause_weight[c];
+					score[lit_var(*p)]-=clause_weight[c];
 				}
 				sat(c);
 			}
@@ -633,9 +1130,10 @@ void flip(int flipvar)
 			--sat_count[c];
 			if (sat_count[c] == 1) //sat_count from 2 to 1
 			{
-				for(p=clause_c; (v=p->var_num)!=0; p++)
+				for(p=clause_c; p<clause_e; p++)
 				{
-					if(p->sense == cur_soln[v] )
+					v = lit_var(*p);
+					if(lit_sense(*p) == cur_soln[v] )
 					{
 						score[v] -=clause_weight[c];
 						sat_var[c] = v;
@@ -645,9 +1143,9 @@ void flip(int flipvar)
 			}
 			else if (sat_count[c] == 0) //sat_count from 1 to 0
 			{
-				for(p=clause_c; (v=p->var_num)!=0; p++)
+				for(p=clause_c; p<clause_e; p++)
 				{
-					score[v] +=clause_weight[c];
+					score[lit_var(*p)] +=clause_weight[c];
 				}
 				score[flipvar]+=clause_weight[c];
 				unsat(c);
@@ -658,39 +1156,63 @@ void flip(int flipvar)
 		}//end else
 	}
 	
-	int * np = var_neighbor[flipvar];
-	for(; (v=*np)!=0; np++)
+	if(neighbor_lazy)
 	{
-		conf_change[v] = 1;
+		for(q=var_lit+var_lit_start[flipvar]; q<qe; q++)
+		{
+			c = occ_clause(*q);
+			for(p=clause_lit+clause_lit_start[c], clause_e=clause_lit+clause_lit_start[c+1]; p<clause_e; p++)
+			{
+				v = lit_var(*p);
+				if (conf_change[v]) continue;
+				conf_change[v] = 1;
+				if (unsat_app_count[v]) ccd_add(v);
+			}
+		}
+	}
+	else
+	{
+		int* np = var_neighbor+var_neighbor_start[flipvar];
+		int* ne = var_neighbor+var_neighbor_start[flipvar+1];
+		for(; np<ne; np++)
+		{
+			v = *np;
+			if (conf_change[v]) continue;
+			conf_change[v] = 1;
+			if (unsat_app_count[v]) ccd_add(v);
+		}
 	}
 	//update information of flipvar
+	if (conf_change[flipvar] && unsat_app_count[flipvar]) ccd_remove(flipvar);
 	conf_change[flipvar] = 0;
+	flips++;
+	time_stamp[flipvar] = step;
 }
 
 
 /*the following functions are non-algorithmic*/
 
-void print_solution()
+void print_solution(int* soln, int n)
 {
      printf("v");
-     for (int i=1; i<=num_vars; i++) {
+     for (int i=1; i<=n; i++) {
 		printf(" ");
-		if(best_soln[i]==0) printf("-");
+		if(soln[i]==0) printf("-");
 		printf("%d", i);
      }
      printf("\n");
      fflush(stdout);
 }
 
-int verify_sol_non_partial()
+int verify_sol_non_partial(int* best_soln)
 {
 	int c,j,flag;
 	unsigned long long verify_weights=0ll;
 	for (c = 0; c<num_clauses; ++c) 
 	{
 		flag = 0;
-		for(j=0; j<clause_lit_count[c]; ++j)
-			if (best_soln[clause_lit[c][j].var_num] == clause_lit[c][j].sense) {flag = 1; break;}
+		for(j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
+			if (best_soln[lit_var(clause_lit[j])] == lit_sense(clause_lit[j])) {flag = 1; break;}
 
 		if(flag ==0){//output the clause unsatisfied by the solution
 			verify_weights += clause_weight[c];
@@ -701,15 +1223,15 @@ int verify_sol_non_partial()
 	return 0;
 }
 
-int verify_sol_partial()
+int verify_sol_partial(int* best_soln)
 {
 	int c,j,flag;
 	unsigned long long verify_weights=0ll;
 	for (c = 0; c<num_clauses; ++c) 
 	{
 		flag = 0;
-		for(j=0; j<clause_lit_count[c]; ++j)
-			if (best_soln[clause_lit[c][j].var_num] == clause_lit[c][j].sense) {flag = 1; break;}
+		for(j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
+			if (best_soln[lit_var(clause_lit[j])] == lit_sense(clause_lit[j])) {flag = 1; break;}
 
 		if(flag ==0){//output the clause unsatisfied by the solution
 			verify_weights += clause_weight[c];
@@ -0,0 +1,114 @@
+/* Multi-process cooperative solving for the CCLS driver
+ *
+ * A coordinator process fixes the top <co_depth> branching atoms of the initial A0 ordering
+ * (<co_atoms>) and so splits the search space into 2^<co_depth> cubes; bit i of a cube
+ * number is the value of co_atoms[i]. Each of <co_workers> forked worker processes searches
+ * one cube at a time and talks to the coordinator over its own Unix domain socket pair.
+ * Every message starts with a co_message header; CO_CUBE and CO_DONE are followed by an
+ * assignment of num_vars+1 ints when they have a cost, that is when it is not NO_COST.
+ *
+ *   coordinator -> worker   CO_CUBE      search <cube>, starting from the global best
+ *                           CO_BEST      <cost> is the new global best
+ *                           CO_STOP      no cubes are left
+ *   worker -> coordinator   CO_IMPROVED  the worker found an assignment of cost <cost>
+ *                           CO_DONE      <cube> is finished, with <num_unsat> and the
+ *                                        worker's best assignment
+ */
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define CO_MAX_DEPTH 20
+
+enum CO_TYPE {CO_CUBE, CO_BEST, CO_STOP, CO_IMPROVED, CO_DONE};
+
+struct co_message
+{
+	int					type;
+	int					cube;
+	unsigned long long	num_unsat;		//result reported for a finished cube
+	unsigned long long	cost;
+};
+
+int		co_workers = 0;				//number of worker processes, 0 disables the coordinator
+int		co_depth = -1;				//number of fixed atoms per cube, -1 picks one from co_workers
+int		co_atoms[CO_MAX_DEPTH];		//the fixed atoms, in the numbering of the searched formula
+
+/* worker side */
+int		co_socket = -1;						//socket to the coordinator, -1 outside of workers
+unsigned long long	co_global_best = NO_COST;	//best cost the coordinator has announced
+unsigned long long	co_reported = NO_COST;		//best cost this worker has sent
+
+
+/* number of cube atoms for <co_workers> workers: about four cubes per worker */
+int co_default_depth()
+{
+	int depth = 0;
+	while ((1<<depth) < 4*co_workers && depth < CO_MAX_DEPTH) ++depth;
+	return min(depth, num_vars);
+}
+
+int co_write_all(int fd, const void* buf, size_t len)
+{
+	const char*	p = (const char*) buf;
+	ssize_t		n;
+	while (len>0)
+	{
+		n = write(fd, p, len);
+		if (n<0 && errno==EINTR) continue;
+		if (n<=0) return 0;
+		p += n;
+		len -= n;
+	}
+	return 1;
+}
+
+int co_read_all(int fd, void* buf, size_t len)
+{
+	char*	p = (char*) buf;
+	ssize_t	n;
+	while (len>0)
+	{
+		n = read(fd, p, len);
+		if (n<0 && errno==EINTR) continue;
+		if (n<=0) return 0;
+		p += n;
+		len -= n;
+	}
+	return 1;
+}
+
+/* sends a message, with <soln> attached for CO_CUBE and CO_DONE; returns 0 if the peer is gone */
+int co_send(int fd, int type, int cube, unsigned long long num_unsat, unsigned long long cost, const int* soln)
+{
+	co_message msg;
+	msg.type = type;
+	msg.cube = cube;
+	msg.num_unsat = num_unsat;
+	msg.cost = cost;
+	if (!co_write_all(fd, &msg, sizeof(msg))) return 0;
+	if ((type==CO_CUBE || type==CO_DONE) && cost!=NO_COST)
+		return co_write_all(fd, soln, (num_vars+1)*sizeof(int));
+	return 1;
+}
+
+/* receives a message into <msg> and its assignment, if any, into <soln>; returns 0 if the peer is gone */
+int co_receive(int fd, co_message& msg, int* soln)
+{
+	if (!co_read_all(fd, &msg, sizeof(msg))) return 0;
+	if ((msg.type==CO_CUBE || msg.type==CO_DONE) && msg.cost!=NO_COST)
+		return co_read_all(fd, soln, (num_vars+1)*sizeof(int));
+	return 1;
+}
+
+/* whether a message is waiting on <fd> */
+int co_pending(int fd)
+{
+	struct pollfd p;
+	p.fd = fd;
+	p.events = POLLIN;
+	return poll(&p, 1, 0)>0;
+}
@@ -0,0 +1,108 @@
+/* Hardware counters of the UCT phases, for builds with -DUCT_STATS
+ *
+ * With -x, each engine opens a group of perf_event counters on its own thread at the start of
+ * a run. The UCT loop samples the group at every phase boundary and charges the counts since
+ * the previous sample to the phase that just ended: leaf setup (init), SLS flips
+ * (local_search), branching (setBranchingAtom), and descent for everything else, mostly
+ * playNode on the way down and back up. A sample is one read() of the whole group, a few
+ * hundred ns, so the counters are for attribution rather than for timing runs. Events the
+ * kernel refuses (perf_event_paranoid, virtual machines without a PMU) are left out and
+ * reported as n/a.
+ */
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+enum HW_EVENT {HW_CYCLES, HW_INSTRUCTIONS, HW_L1D_MISSES, HW_LLC_MISSES, HW_BRANCH_MISSES, HW_EVENTS};
+enum HW_PHASE {HW_DESCENT, HW_SETUP, HW_SLS, HW_BRANCHING, HW_PHASES};
+
+const char* hw_event_names[HW_EVENTS] = {"cycles", "instructions", "L1d misses", "LLC misses", "branch misses"};
+const char* hw_phase_names[HW_PHASES] = {"descent", "setup", "sls", "branching"};
+
+int hw_enabled = 0;		//whether -x asks for the counters
+
+
+void hw_attr(int event, perf_event_attr& attr)
+{
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	switch (event)
+	{
+	case HW_CYCLES:			attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+	case HW_INSTRUCTIONS:	attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+	case HW_LLC_MISSES:		attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+	case HW_BRANCH_MISSES:	attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+	case HW_L1D_MISSES:
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16);
+		break;
+	}
+	attr.read_format = PERF_FORMAT_GROUP;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+}
+
+/* The counters of the calling thread, as one perf_event group */
+struct hw_group
+{
+	int		fd[HW_EVENTS];		//-1 for the events that could not be opened, fd[0] leads the group
+	int		slot[HW_EVENTS];	//position of each event in a group read, -1 if it is not counted
+	int		size;				//number of events in the group
+	unsigned long long	last[HW_EVENTS];	//counts at the previous sample
+
+	hw_group() : size(0) {
+		for (int e=0; e<HW_EVENTS; ++e) fd[e] = slot[e] = -1;
+	}
+	~hw_group() { stop(); }
+
+	/* opens the group on the calling thread, leaving it closed if even the cycles counter fails */
+	void start() {
+		perf_event_attr attr;
+		int e;
+		stop();
+		for (e=0; e<HW_EVENTS; ++e)
+		{
+			hw_attr(e, attr);
+			attr.disabled = (e==0);
+			fd[e] = syscall(__NR_perf_event_open, &attr, 0, -1, e ? fd[0] : -1, 0);
+			if (fd[0]<0) return;
+			if (fd[e]>=0) slot[e] = size++;
+		}
+		ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		memset(last, 0, sizeof(last));
+		sample(NULL);
+	}
+
+	void stop() {
+		for (int e=0; e<HW_EVENTS; ++e)
+		{
+			if (fd[e]>=0) ::close(fd[e]);
+			fd[e] = slot[e] = -1;
+		}
+		size = 0;
+	}
+
+	/* adds the counts since the previous sample to <counts>, if given */
+	void sample(unsigned long long* counts) {
+		unsigned long long buf[1+HW_EVENTS];
+		int e;
+		if (read(fd[0], buf, (1+size)*sizeof(unsigned long long)) <= 0) return;
+		for (e=0; e<HW_EVENTS; ++e)
+		{
+			if (slot[e]<0) continue;
+			if (counts) counts[e] += buf[1+slot[e]] - last[e];
+			last[e] = buf[1+slot[e]];
+		}
+	}
+
+	/* bit e is set if event e is counted */
+	int events() {
+		int e, mask = 0;
+		for (e=0; e<HW_EVENTS; ++e)
+			if (slot[e]>=0) mask |= 1<<e;
+		return mask;
+	}
+};
@@ -1,8 +1,12 @@
 #include "basic_uct.h"
+#include "preprocess.h"
+#include "renumber.h"
+#include "cooperate.h"
+#include "steal.h"
+#include "results.h"
+#include "trace.h"
 #include <unistd.h>
 
-unsigned long long step;
-
 const int RAND_MAX_INT = 10000000; //used for random number generation
 
 
@@ -11,45 +15,90 @@ int numRuns = 10;
 double C = 0.02; // exploration bias parameter for UCT
 int prob = 2000000; // CCLS noise parameter
 int maxFlips = 1000; // number of flips in each CCLS run
+int evaluator = CCLS; // SLS algorithm used for leaf node value estimation
 char *filename; // .cnf filename
-int runTimeout = 15; // run timeout in seconds
+double runTimeout = 15; // run timeout in seconds
+int cpuTimeout = 0; // whether the run timeout is measured in process CPU time instead of wall time
+int simplify = 0; // whether to preprocess the formula before search
+int locality = 0; // whether to renumber variables and clauses for locality
+int printModel = 0; // whether to print the best assignment found
+int maxIterations = 0; // UCT iterations per run and engine, 0 for no limit
+int deterministic = 0; // whether runs are reproducible from <masterSeed>
+unsigned int masterSeed; // seed all random number streams are derived from
+
+int numThreads = 1; // number of engines searching concurrently in each run
+int portfolio = 0; // whether the engines run different evaluators and share their incumbent
+
+/* PORTFOLIO */
+#define SHARE_INTERVAL 16 // UCT iterations between two exchanges with the shared incumbent
+
+struct portfolioEntry {
+  int evaluator;
+  double C;
+  double noise;
+  int maxFlips;
+};
+
+// configurations of engines 1,2,... in portfolio mode, engine 0 uses the command line parameters
+const portfolioEntry portfolioTable[] = {
+  {WALKSAT, 0.02, 0.5, 1000},
+  {NOVELTY, 0.05, 0.2, 1000},
+  {CCLS,    0.1,  0.0, 4000},
+  {WALKSAT, 0.05, 0.3, 250},
+  {NOVELTY, 0.01, 0.5, 4000},
+  {CCLS,    0.01, 0.4, 250}
+};
+const int portfolioSize = sizeof(portfolioTable)/sizeof(portfolioTable[0]);
+
+const char *evaluatorNames[] = {"CCLS14", "WalkSAT", "Novelty"};
+
+Incumbent *incumbent; // best assignment found by any engine in the current run
+
+/* DETERMINISTIC MODE */
+vector<Engine*> engines; // the engines of performRuns, in the order of their ids
+EpochBarrier *epochBarrier; // synchronises the engines at the end of each epoch
+vector<unsigned long long> epochCost; // best cost of each engine at the end of the current epoch
 
 /* GLOBAL VARIABLES */
-uctnode* root; // pointer to root node of UCT search tree
-int nextBranchingAtom; // the next atom to branch on given the current formula
-short timeFlag; // used for timeouts
+atomic<bool> timeFlag; // cleared by the first engine that sees the run deadline expire, set before the engines start
+Deadline runDeadline; // end of the current run
+#define DEADLINE_CHECK 256 // flips between two reads of the clock in local_search
 
-clock_t opt_start, opt_stop; // used for finding time to optimal
-short clockStopped; // used for finding time to optimal
+double runStart; // monotonic time at which the current run started
+int printTrajectory = 0; // whether to print the anytime profile of each run
+double statsInterval = 0; // seconds between periodic reports of the UCT counters, 0 for none
 
-double bestReward;
-unsigned long long bestNumUnsat;
-double bestRewardAtTimeout;
+int* bestModel; // best assignment over all runs, in the numbering of the input file
+int* renumberBuffer; // scratch space of mapSolution, in the numbering of the searched formula
 
-int* varScores; //used in setBranchingAtom
-int* bestVars; //used in setBranchingAtom
 
-int best_array[MAX_VARS];
-int best_array_count;
+/* Seed of the random number stream of engine <k>, derived from <masterSeed> by splitmix64 */
+unsigned int streamSeed(int k) {
+  unsigned long long state = masterSeed + k*0x9E3779B97F4A7C15ULL;
+  return (unsigned int) splitmix64(state);
+}
 
 
 /* Main UCT Method -- Plays the selected node */
-double playNode(uctnode *node) {
+double Engine::playNode(uctnode *node) {
   double reward;
   short armPlayed;
   
   // Set this node's variable to be immutable
-  varMutable[node->atom] = 0;
+  clear_bit(varMutable, node->atom);
   
   // If neither arm has been played, play them both
   if (node->n[LEFT]==0) {
     node->n[LEFT] = node->n[RIGHT] = 1;
+    maxDepth = max(maxDepth, node->depth);
+    STATS(stats.leafDepth += BF*node->depth);
     // play the left arm
     cur_soln[node->atom] = LEFT;
     node->x[LEFT] = estimateReward();
     if (closedFlag) {
       closedFlag=0;
       node->closed[LEFT]=1;
+      STATS(stats.closedArms++);
     }
     else {
       node->nextAtom[LEFT] = nextBranchingAtom;
@@ -60,6 +109,7 @@ double playNode(uctnode *node) {
     if (closedFlag) {
       closedFlag=0;
       node->closed[RIGHT]=1;
+      STATS(stats.closedArms++);
     }
     else {
       node->nextAtom[RIGHT] = nextBranchingAtom;
@@ -68,16 +118,25 @@ double playNode(uctnode *node) {
     armPlayed = BOTH;
     // If the depth limit has been reached, close both arms
     if (node->depth >= depthLimit) {
+      STATS(stats.closedArms += !node->closed[LEFT] + !node->closed[RIGHT]);
       node->closed[LEFT] = node->closed[RIGHT] = 1;
     }
+    if (tr_file) {
+      traceLeaf = node->atom;
+      traceReward[LEFT] = node->x[LEFT];
+      traceReward[RIGHT] = node->x[RIGHT];
+      traceClosed = node->closed[LEFT] | node->closed[RIGHT]<<1;
+    }
   }
   
   // If the left arm is closed, play the right
   else if (node->closed[LEFT]) {
     node->n[RIGHT]++;
     cur_soln[node->atom] = RIGHT;
+    if (tr_file) tracePath.push_back(node->atom<<1 | RIGHT);
     if (!(node->children)) {
       createChildren(node);
+      nodes += BF;
     }
     reward = playNode(node->children[RIGHT]);
     node->x[RIGHT]+=(reward-node->x[RIGHT])/node->n[RIGHT];
@@ -88,8 +147,10 @@ double playNode(uctnode *node) {
   else if (node->closed[RIGHT]) {
     node->n[LEFT]++;
     cur_soln[node->atom] = LEFT;
+    if (tr_file) tracePath.push_back(node->atom<<1 | LEFT);
     if (!(node->children)) {
       createChildren(node);
+      nodes += BF;
     }
     reward = playNode(node->children[LEFT]);
     node->x[LEFT]+=(reward-node->x[LEFT])/node->n[LEFT];
@@ -101,8 +162,10 @@ double playNode(uctnode *node) {
     armPlayed = selectMove(node);
     node->n[armPlayed]++;
     cur_soln[node->atom] = armPlayed;
+    if (tr_file) tracePath.push_back(node->atom<<1 | armPlayed);
     if (!(node->children)) {
       createChildren(node);
+      nodes += BF;
     }
     reward = playNode(node->children[armPlayed]);
     node->x[armPlayed]+=(reward-node->x[armPlayed])/node->n[armPlayed];
@@ -113,13 +176,17 @@ double playNode(uctnode *node) {
   switch (armPlayed) {
       
   case (LEFT):
-    if (node->children[LEFT]->closed[LEFT] && node->children[LEFT]->closed[RIGHT])
+    if (node->children[LEFT]->closed[LEFT] && node->children[LEFT]->closed[RIGHT]) {
+      STATS(stats.closedArms += !node->closed[LEFT]);
       node->closed[LEFT] = 1;
+    }
     break;
           
   case (RIGHT):
-    if (node->children[RIGHT]->closed[LEFT] && node->children[RIGHT]->closed[RIGHT])
+    if (node->children[RIGHT]->closed[LEFT] && node->children[RIGHT]->closed[RIGHT]) {
+      STATS(stats.closedArms += !node->closed[RIGHT]);
       node->closed[RIGHT] = 1;
+    }
     break;
 
   }
@@ -130,7 +197,7 @@ double playNode(uctnode *node) {
 
 
 /* Subroutine in UCT search -- given a node, it decides which child UCT should expand */
-short selectMove(uctnode *node) {
+short Engine::selectMove(uctnode *node) {
   float scoreL, scoreR;
   
   // Calculate the UCB1 scores for the two arms
@@ -140,7 +207,7 @@ short selectMove(uctnode *node) {
   scoreR += C*sqrt(log(node->n[LEFT]+node->n[RIGHT])/ (float) node->n[RIGHT]);
   // If they are equal, pick one uniformly at random
   if (scoreL==scoreR) {
-    return rand()%BF;
+    return randomBelow(BF);
   }
   // Otherwise, pick the arm with the larger score
   return (scoreR>scoreL);
@@ -148,39 +215,81 @@ short selectMove(uctnode *node) {
 
 
 /* Estimates the value of a leaf node by performing SLS */
-double estimateReward() {
+double Engine::estimateReward() {
   double reward;
+  unsigned long long cost;
+  STATS(double start = Deadline::now(0), searchStart, branchStart; hwSample(HW_DESCENT));
   
   // Initialize the SLS run
   init(); 
+  STATS(searchStart = Deadline::now(0); hwSample(HW_SETUP));
   
-  // Perform SLS using a UBCSAT algorithm
-  reward = (double) (num_clauses-local_search())/(double)num_clauses;
-  
-  // Take the reward to be the portion of satisfied clauses squared
-  reward *= reward;
+  // No assignment below a falsified hard clause is feasible, so the arm closes without SLS
+  if (infeasibleFlag) {
+    closedFlag = 1;
+    reward = MIN_REWARD;
+    STATS(branchStart = searchStart);
+  }
+  else {
+    cost = local_search();
+    STATS(branchStart = Deadline::now(0); hwSample(HW_SLS));
+    reward = leafReward(cost);
+    traceCost = min(traceCost, cost);
+  }
   
   // Determine which atom to branch on next
   if (!closedFlag) {
     setBranchingAtom();
   }
-  
-  bestReward = (reward > bestReward) ? reward : bestReward;
+  STATS(
+    hwSample(HW_BRANCHING);
+    stats.evaluations++;
+    stats.initTime += searchStart-start;
+    stats.slsTime += branchStart-searchStart;
+    stats.branchTime += Deadline::now(0)-branchStart;
+  )
   
   return reward;
 }
 
 
-/* Returns the number of unsat clauses given a UCT reward */
-int getNumUnsat(double reward) {
-  return (int) rint(num_clauses - num_clauses*sqrt(reward));
+/* Returns the reward of a leaf whose SLS run reached <cost>, squared. Without hard clauses it
+ * is the portion of satisfied clause weight. On partial instances the hard weight would push
+ * every feasible leaf next to 1, so a leaf that falsifies a hard clause earns MIN_REWARD and
+ * the others the portion of the soft weight above the incumbent that they keep satisfied. */
+double Engine::leafReward(unsigned long long cost) {
+  double reward;
+  
+  if (probtype!=WEIGHTED_PARTIAL) {
+    reward = (double) (total_clause_weight-cost)/(double)total_clause_weight;
+  }
+  else if (cost >= (unsigned long long)hard_clause_weight) {
+    return MIN_REWARD;
+  }
+  // local_search has already taken <cost> into <bestNumUnsat>, so the leaf is never better
+  else if (bestNumUnsat >= total_soft_weight) {
+    reward = 1.0;
+  }
+  else {
+    reward = 1.0 - (double) (cost-bestNumUnsat)/(double)(total_soft_weight-bestNumUnsat);
+  }
+  return reward*reward;
+}
+
+
+/* Returns the best cost of the run in the original formula, the total clause weight if no
+ * leaf has been evaluated */
+unsigned long long Engine::bestCost() {
+  return (bestNumUnsat!=NO_COST ? bestNumUnsat : total_clause_weight) + pp_cost_offset;
 }
 
 
 /* Sets the root node of the UCT search tree */
-void setRootNode() {
+void Engine::setRootNode() {
   root = new uctnode;
   if (!root) printMemoryError();
+  nodes++;
+  STATS(countTreeBytes(sizeof(uctnode)));
   root->depth = 0;
   root->x[LEFT] = root->x[RIGHT] = MIN_REWARD;
   root->n[LEFT] = root->n[RIGHT] = 0;
@@ -193,24 +302,29 @@ void setRootNode() {
 
 
 /* Branching heuristic: A0 */
-void setBranchingAtom() {
-  int j, k;
+void Engine::setBranchingAtom() {
+  int j, k, w;
+  bitword bits;
   int bestScore = -1;
   int numBest = 0;
   
-  for (j=0; j<num_vars; j++) {
+  for (j=1; j<=num_vars; j++) {
     varScores[j] = 0;
   }
-  // Collect the variable scores
-  for (j=0; j<num_clauses; j++) {
-    if (preSat[j]) continue; // don't consider preSat clauses
-    for (k=0;k<clause_lit_count[j];++k) {
-      varScores[clause_lit[j][k].var_num]++;
+  // Collect the variable scores, skipping over preSat clauses a word at a time
+  for (w=0; w<bitset_words(num_clauses); w++) {
+    bits = ~preSat[w];
+    while (bits) {
+      j = (w<<6) + __builtin_ctzll(bits);
+      bits &= bits-1;
+      for (k=clause_lit_start[j];k<clause_lit_start[j+1];++k) {
+        varScores[lit_var(clause_lit[k])]++;
+      }
     }
   }
   // Search for the best score, break ties uniformly at random
   for (j=1; j<=num_vars; j++) {
-    if (!varMutable[j]) continue;
+    if (!is_mutable(j)) continue;
     
     if (varScores[j]>bestScore) {
       bestScore = varScores[j];
@@ -225,7 +339,7 @@ void setBranchingAtom() {
     nextBranchingAtom=0;
   }
   else {
-    nextBranchingAtom = bestVars[rand()%numBest];
+    nextBranchingAtom = bestVars[randomBelow(numBest)];
   }
   
 }
@@ -251,6 +365,7 @@ void createChildren(uctnode *node) {
   int i;
   node->children = new uctnode*[BF];
   if (!node->children) printMemoryError();
+  STATS(countTreeBytes(BF*(sizeof(uctnode)+sizeof(uctnode*))));
   for (i=0; i<BF; i++) {
     node->children[i] = getNewNode(node, i);
   }
@@ -268,56 +383,45 @@ void freeNode(uctnode *node) {
     if (node->children[RIGHT]) {
       freeNode(node->children[RIGHT]);
     }
+    STATS(countTreeBytes(-(long long)(BF*sizeof(uctnode*))));
   }
-  delete node->children;
+  STATS(countTreeBytes(-(long long)sizeof(uctnode)));
+  delete[] node->children;
   delete node;
 }
 
 
 /* CCLS method -- picks a variable to flip from an unsatisfied clause */
-int pick_var()
+int Engine::pick_var()
 {
 	int     i,c,v;
 	int     best_score=0;
 	int		v_score;
 	
-	if(rand()%RAND_MAX_INT<prob)
+	if(randomBelow(RAND_MAX_INT)<prob)
 	{
 		int 
-		c = unsat_stack[rand()%unsat_stack_fill_pointer];
+		c = unsat_stack[randomBelow(unsat_stack_fill_pointer)];
 
 		best_array_count=0;
 		
-		for (i=0; i<clause_lit_count[c]; i++) {
-		  v = clause_lit[c][i].var_num;
-		  if (varMutable[v]) { // only consider mutable variables
+		for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; i++) {
+		  v = lit_var(clause_lit[i]);
+		  if (is_mutable(v)) { // only consider mutable variables
 		    best_array[best_array_count++] = v;
 		  }
 		}
-		return best_array[rand()%best_array_count];
+		return best_array[randomBelow(best_array_count)];
 	}
 	
+	// the greedy step only looks at the candidates of <ccd_stack>, the configuration
+	// changed mutable variables in unsat clauses
 	best_array_count=0;
-	for(i=0; i<unsatvar_stack_fill_pointer; i++)
+	for(i=0; i<ccd_stack_fill_pointer; i++)
 	{
-		v = unsatvar_stack[i];
-		if (!varMutable[v]) continue;
-		if(conf_change[v]==1)
-		{
-			best_array[0] = v;
-			best_array_count=1;
-			best_score = score[v];
-			break;
-		}
-	}
-	for(i++; i<unsatvar_stack_fill_pointer; i++)
-	{
-		v = unsatvar_stack[i];
-		if (!varMutable[v]) continue;
-		if(conf_change[v]==0)
-			continue;
+		v = ccd_stack[i];
 		v_score = score[v];
-		if(v_score>best_score)
+		if(best_array_count==0 || v_score>best_score)
 		{
 			best_array[0] = v;
 			best_array_count=1;
@@ -328,18 +432,97 @@ int pick_var()
 	}
 	
 	if(best_array_count>0)
-		return best_array[rand()%best_array_count];
+		return best_array[randomBelow(best_array_count)];
 	
-	c = unsat_stack[rand()%unsat_stack_fill_pointer];
-	return clause_lit[c][rand()%clause_lit_count[c]].var_num;
+	c = unsat_stack[randomBelow(unsat_stack_fill_pointer)];
+	return lit_var(clause_lit[clause_lit_start[c]+randomBelow(clause_lit_count[c])]);
 }
  
 
-/* Main CCLS method -- performs local search*/
-int local_search()
+/* WalkSAT method -- weight of the clauses that become unsatisfied when <v> is flipped */
+int Engine::break_weight(int v)
+{
+	int i,c;
+	int weight=0;
+	
+	for (i=var_lit_start[v]; i<var_lit_start[v+1]; i++) {
+		c = occ_clause(var_lit[i]);
+		if (!is_presat(c) && sat_count[c]==1 && sat_var[c]==v)
+			weight += clause_weight[c];
+	}
+	return weight;
+}
+
+
+/* WalkSAT method -- picks a variable to flip from a random unsatisfied clause. The result may
+ * be immutable, or 0 if the clause has no mutable variable; local_search skips both. */
+int Engine::pick_var_walksat()
+{
+	int     i,c,v;
+	int     best_break=INT_MAX;
+	int		v_break;
+	
+	c = unsat_stack[randomBelow(unsat_stack_fill_pointer)];
+	
+	best_array_count=0;
+	for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; i++) {
+		v = lit_var(clause_lit[i]);
+		if (!is_mutable(v)) continue;
+		v_break = break_weight(v);
+		if (v_break<best_break) {
+			best_array[0] = v;
+			best_array_count=1;
+			best_break = v_break;
+		}
+		else if (v_break==best_break)
+			best_array[best_array_count++] = v;
+	}
+	
+	// a freebie is always taken, otherwise a random walk step with probability <prob>
+	if (best_break>0 && randomBelow(RAND_MAX_INT)<prob) {
+		return lit_var(clause_lit[clause_lit_start[c]+randomBelow(clause_lit_count[c])]);
+	}
+	if (best_array_count==0)
+		return 0;
+	return best_array[randomBelow(best_array_count)];
+}
+
+
+/* Novelty method -- picks the best variable of a random unsatisfied clause, or the second
+ * best with probability <prob> if the best is the most recently flipped one */
+int Engine::pick_var_novelty()
+{
+	int     i,c,v;
+	int     best=0, second=0, youngest=0;
+	
+	c = unsat_stack[randomBelow(unsat_stack_fill_pointer)];
+	
+	for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; i++) {
+		v = lit_var(clause_lit[i]);
+		if (!is_mutable(v)) continue;
+		if (!youngest || time_stamp[v]>time_stamp[youngest])
+			youngest = v;
+		// ties go to the variable flipped longest ago
+		if (!best || score[v]>score[best] || (score[v]==score[best] && time_stamp[v]<time_stamp[best])) {
+			second = best;
+			best = v;
+		}
+		else if (!second || score[v]>score[second] || (score[v]==score[second] && time_stamp[v]<time_stamp[second])) {
+			second = v;
+		}
+	}
+	
+	if (best==youngest && second && randomBelow(RAND_MAX_INT)<prob)
+		return second;
+	return best;
+}
+
+
+/* Main CCLS method -- performs local search, and returns the lowest cost it reached */
+unsigned long long Engine::local_search()
 {
 	int flipvar,v,j;
-	unsigned long long local_opt_unsat_clause_weight = total_unsat_clause_weight+numPreFalsifiedClauses;
+	unsigned long long local_opt_unsat_clause_weight = total_unsat_clause_weight+preFalsifiedWeight;
 
 	if(local_opt_unsat_clause_weight<bestNumUnsat)
 	{
@@ -348,6 +531,7 @@ int local_search()
 		
 		for(v=1; v<=num_vars; v++)
 			best_soln[v] = cur_soln[v];
+		recordImprovement();
 
 	}
 	if(total_unsat_clause_weight==0)
@@ -358,13 +542,14 @@ int local_search()
 	for(step=0; step<maxFlips; step++)
 	{
 
-		if(total_unsat_clause_weight+numPreFalsifiedClauses<local_opt_unsat_clause_weight)
+		if(total_unsat_clause_weight+preFalsifiedWeight<local_opt_unsat_clause_weight)
 		{
-			local_opt_unsat_clause_weight=total_unsat_clause_weight+numPreFalsifiedClauses;
+			local_opt_unsat_clause_weight=total_unsat_clause_weight+preFalsifiedWeight;
 		    if (local_opt_unsat_clause_weight<bestNumUnsat) {
 				bestNumUnsat=local_opt_unsat_clause_weight;
 				for(v=1; v<=num_vars; v++)
 					best_soln[v] = cur_soln[v];
+				recordImprovement();
 			}
 			
 			
@@ -375,41 +560,210 @@ int local_search()
 			return local_opt_unsat_clause_weight;
 		}
 
-		flipvar = pick_var();
+		// stop mid-playout at the deadline, reading the clock every DEADLINE_CHECK flips
+		if(!timeFlag.load(memory_order_relaxed) || (step%DEADLINE_CHECK==0 && runDeadline.expired()))
+		{
+			timeFlag.store(false, memory_order_relaxed);
+			break;
+		}
+
+		switch (evaluator) {
+		  case WALKSAT:
+		    flipvar = pick_var_walksat();
+		    break;
+		  case NOVELTY:
+		    flipvar = pick_var_novelty();
+		    break;
+		  default:
+		    flipvar = pick_var();
+		}
 
-		if (varMutable[flipvar]) {
+		if (flipvar && is_mutable(flipvar)) {
 			flip(flipvar);
 		}
 	}
 	
-	return local_opt_unsat_clause_weight+numPreFalsifiedClauses;
+	return local_opt_unsat_clause_weight;
 }
 
 
 /* Set <varMutable> array */
-void setMutable() {
+void Engine::setMutable() {
   int i;
-  for (i=1; i<=num_vars; i++) {
-    varMutable[i] = 1;
+  
+  set_all_bits(varMutable, num_vars+1);
+  // the atoms of a cube keep their values throughout the run
+  for (i=0; i<cubeSize; i++) {
+    clear_bit(varMutable, cubeAtoms[i]);
+    cur_soln[cubeAtoms[i]] = (cube>>i)&1;
   }
 }
 
 
-/* Performs a single timed UCT run and returns the best number of unsat clauses found */
-int runUCTtimed() {
+/* Exchanges the best assignment with the other engines of the run: publishes it if it beats
+ * the shared incumbent, and in portfolio mode adopts the incumbent as the starting point of
+ * later playouts if it is better. Neither direction blocks; a snapshot that collides with a
+ * writer is simply retried at the next exchange. */
+void Engine::shareIncumbent() {
+  unsigned long long cost;
   
-  bestReward=MIN_REWARD;
-  bestNumUnsat=BIG_LONG;
+  if (incumbent->publish(bestNumUnsat, best_soln)) return;
+  if (portfolio && incumbent->cost.load(memory_order_relaxed) < bestNumUnsat) {
+    // cur_soln is rebuilt by the next playout, so it can hold the snapshot
+    if (incumbent->snapshot(cost, cur_soln)) {
+      bestNumUnsat = cost;
+      memcpy(best_soln, cur_soln, (num_vars+1)*sizeof(int));
+    }
+  }
+}
+
+
+/* Resets the anytime profile at the start of a run */
+void Engine::startTrajectory() {
+  iterations = nodes = flips = 0;
+  maxDepth = 0;
+  traceFlips = 0;
+  traceCost = TR_NO_COST;
+  trajectory.clear();
+  STATS(
+    stats = uctStats();
+    nextStatsReport = runStart + statsInterval;
+    if (hw_enabled) {
+      hw.start();
+      stats.hwEvents = hw.events();
+    }
+  )
+}
+
+
+/* Puts the record of the iteration that just ended into the engine's trace ring */
+void Engine::traceIteration() {
+  tr_record record;
+  size_t pathBytes = tracePath.size()*sizeof(unsigned int);
   
-  // Install the timeout handler and set the alarm
-  signal(SIGALRM, ALARMhandler);
-  timeFlag = 1;
-  alarm(runTimeout);
+  record.reward[LEFT] = traceReward[LEFT];
+  record.reward[RIGHT] = traceReward[RIGHT];
+  record.cost = traceCost;
+  record.run = tr_run;
+  record.engine = id;
+  record.cube = cube;
+  record.task = task;
+  record.iteration = iterations+1;
+  record.flips = flips - traceFlips;
+  record.leaf = traceLeaf;
+  record.closed = traceClosed;
+  record.depth = tracePath.size();
+  traceBuffer.resize(sizeof(record) + pathBytes);
+  memcpy(traceBuffer.data(), &record, sizeof(record));
+  memcpy(traceBuffer.data() + sizeof(record), tracePath.data(), pathBytes);
+  tr_rings[id]->put(traceBuffer.data(), traceBuffer.size());
+  tracePath.clear();
+  traceFlips = flips;
+  traceCost = TR_NO_COST;
+}
+
+
+/* Records the improvement of <bestNumUnsat> that was just made */
+void Engine::recordImprovement() {
+  trajectoryPoint point;
+  
+  point.time = Deadline::now(0) - runStart;
+  point.iteration = iterations+1;
+  point.nodes = nodes;
+  point.flips = flips;
+  point.cost = bestNumUnsat + pp_cost_offset;
+  trajectory.push_back(point);
+}
+
+
+/* Prints the hot-path counters <s> of <flips> flips, <iterations> UCT iterations and <nodes>
+ * nodes over <elapsed> seconds */
+void printStats(const char *label, const uctStats &s, unsigned long long flips,
+                unsigned long long iterations, unsigned long long nodes, double elapsed) {
+  double total = max(s.iterationTime, 1e-9);
+  double descent = max(s.iterationTime - s.initTime - s.slsTime - s.branchTime, 0.0);
+  int p, e;
+  
+  elapsed = max(elapsed, 1e-9);
+  printf("%s: %.0f flips/s, %.0f iterations/s, %.0f evals/s, init %.1f%% sls %.1f%% branching %.1f%% descent %.1f%%, "
+         "leaf depth %.2f, nodes %llu, closed arms %llu, peak tree %.2f MB\n", label,
+         flips/elapsed, iterations/elapsed, s.evaluations/elapsed, 100*s.initTime/total, 100*s.slsTime/total,
+         100*s.branchTime/total, 100*descent/total,
+         s.evaluations ? s.leafDepth/(double)s.evaluations : 0.0, nodes, s.closedArms,
+         peakTreeBytes.load()/1048576.0);
   
-  build_neighbor_relation();
+  // with -x, one line per phase: its hardware counts and instructions per cycle
+  for (p=0; hw_enabled && p<HW_PHASES; p++) {
+    printf("%s %s:", label, hw_phase_names[p]);
+    for (e=0; e<HW_EVENTS; e++) {
+      if (s.hwEvents & (1<<e)) {
+        printf("%s %llu %s", e ? "," : "", s.hw[p][e], hw_event_names[e]);
+      }
+      else {
+        printf("%s n/a %s", e ? "," : "", hw_event_names[e]);
+      }
+    }
+    if ((s.hwEvents & (1<<HW_CYCLES)) && (s.hwEvents & (1<<HW_INSTRUCTIONS)) && s.hw[p][HW_CYCLES]) {
+      printf(", IPC %.2f", s.hw[p][HW_INSTRUCTIONS]/(double)s.hw[p][HW_CYCLES]);
+    }
+    printf("\n");
+  }
+  fflush(stdout);
+}
+
+
+/* Prints the engine's counters so far in the run, at most once every <statsInterval> seconds */
+void Engine::reportStats() {
+  double now = Deadline::now(0);
+  char label[32];
+  
+  if (now < nextStatsReport) return;
+  nextStatsReport = now + statsInterval;
+  sprintf(label, "Stats engine %d", id);
+  printStats(label, stats, flips, iterations, nodes, now - runStart);
+}
+
+
+/* Deterministic counterpart of shareIncumbent(): at the end of each epoch the engines wait for
+ * each other, then every engine adopts the best assignment of the epoch (the lowest cost, ties
+ * going to the lowest id) if it beats its own. The second wait keeps the winner's assignment
+ * unchanged until all engines have copied it. */
+void Engine::exchangeEpoch() {
+  int k, winner = 0;
+  
+  epochCost[id] = bestNumUnsat;
+  epochBarrier->wait();
+  for (k=1; k<numThreads; k++) {
+    if (epochCost[k] < epochCost[winner]) winner = k;
+  }
+  if (epochCost[winner] < bestNumUnsat) {
+    bestNumUnsat = epochCost[winner];
+    memcpy(best_soln, engines[winner]->best_soln, (num_vars+1)*sizeof(int));
+  }
+  epochBarrier->wait();
+}
+
+
+/* Streams an improvement of the global best to the coordinator, after taking in the global
+ * best costs the coordinator has announced since the last report */
+void Engine::reportToCoordinator() {
+  co_message msg;
   
-  clockStopped=0;
-  opt_start = clock();
+  while (co_pending(co_socket)) {
+    if (!co_receive(co_socket, msg, NULL)) _exit(1);
+    if (msg.type==CO_BEST) co_global_best = min(co_global_best, msg.cost);
+  }
+  if (bestNumUnsat < co_global_best && bestNumUnsat < co_reported) {
+    co_reported = bestNumUnsat;
+    if (!co_send(co_socket, CO_IMPROVED, cube, 0, bestNumUnsat, NULL)) _exit(1);
+  }
+}
+
+
+/* Performs a single timed UCT run and returns the best cost found */
+unsigned long long Engine::runUCTtimed() {
+  bestNumUnsat=NO_COST;
+  startTrajectory();
   
   // all variables begin as mutable
   setMutable();
@@ -417,36 +771,633 @@ int runUCTtimed() {
   // initialize the root node
   setRootNode();
   
-  while (timeFlag) {
-    setMutable();
-    playNode(root);
+  while (timeFlag.load(memory_order_relaxed)) {
+    // the closed arms of a closed tree lead to nodes without an atom, so it is not played again;
+    // a deterministic engine still counts its iterations, which the epochs rely on, and any
+    // other engine has nothing left to search
+    if (root->closed[LEFT] && root->closed[RIGHT] && !deterministic) break;
+    STATS(double start = Deadline::now(0));
+    if (!root->closed[LEFT] || !root->closed[RIGHT]) {
+      setMutable();
+      playNode(root);
+      if (tr_file) traceIteration();
+    }
+    STATS(
+      stats.iterationTime += Deadline::now(0)-start;
+      hwSample(HW_DESCENT);
+      if (statsInterval>0) reportStats();
+    )
+    // a closed tree plays no more SLS, so the clock is also read between iterations
+    if (runDeadline.expired()) timeFlag.store(false, memory_order_relaxed);
+    if (++iterations%SHARE_INTERVAL == 0) {
+      if (deterministic) {
+        if (portfolio && numThreads>1) exchangeEpoch();
+      }
+      else if (numThreads>1) {
+        shareIncumbent();
+      }
+      if (co_socket>=0) reportToCoordinator();
+    }
+    if (iterations==(unsigned long long)maxIterations) break;
   }
+  incumbent->publish(bestNumUnsat, best_soln);
   
   // free memory
   if (root) {
     freeNode(root);
+    root = NULL;
   }
   
-  return getNumUnsat(bestRewardAtTimeout);
+  return bestCost();
 }
 
 
-/* Performs UCT runs and prints the results to stdout */
-void performRuns() {
+/* Sets <co_atoms> to the first <co_depth> atoms the A0 heuristic picks at the root,
+ * before any atom has been assigned */
+void selectCubeAtoms(Engine *engine) {
+  int i;
+  
+  engine->setMutable();
+  engine->init();
+  for (i=0; i<co_depth; i++) {
+    engine->setBranchingAtom();
+    co_atoms[i] = engine->nextBranchingAtom;
+    clear_bit(engine->varMutable, co_atoms[i]);
+  }
+}
+
+
+/* Runs up to <iterations> UCT iterations on the subtree of <task>, and returns whether the
+ * task is still open. A task whose tree has closed is freed. */
+int Engine::runTask(ws_task *task, int iterations) {
   int i;
-  int numUnsat[numRuns];
+  
+  cube = task->cube;
+  cubeSize = task->depth;
+  this->task = task->id;
+  if (!task->root) {
+    setMutable();
+    setRootNode();
+    task->root = root;
+  }
+  root = task->root;
+  
+  for (i=0; i<iterations && timeFlag.load(memory_order_relaxed); i++) {
+    // an atomless root means the cube fixes every variable
+    if (!root->atom || (root->closed[LEFT] && root->closed[RIGHT])) {
+      break;
+    }
+    STATS(double start = Deadline::now(0));
+    setMutable();
+    playNode(root);
+    if (tr_file) traceIteration();
+    this->iterations++;
+    STATS(
+      stats.iterationTime += Deadline::now(0)-start;
+      hwSample(HW_DESCENT);
+      if (statsInterval>0) reportStats();
+    )
+    if (runDeadline.expired()) timeFlag.store(false, memory_order_relaxed);
+  }
+  root = NULL;
+  if (numThreads>1) {
+    shareIncumbent();
+  }
+  
+  return i==iterations || !timeFlag.load(memory_order_relaxed);
+}
+
+
+/* Thread body for the engines of a run with subtree tasks: works through the own deque,
+ * steals when it is empty, and starts a task over the whole search space when no task is
+ * left anywhere */
+void runStealing(Engine *engine, int self, unsigned long long *numUnsat) {
+  ws_task *task;
+  int exhausted;
+  
+  engine->bestNumUnsat = NO_COST;
+  engine->startTrajectory();
+  
+  while (timeFlag.load(memory_order_relaxed)) {
+    task = ws_deques[self]->take();
+    if (!task) {
+      task = ws_steal(self, engine->randomBelow(ws_deques.size()));
+    }
+    if (!task) {
+      task = new ws_task(0, 0);
+    }
+    if (engine->runTask(task, WS_SLICE)) {
+      ws_deques[self]->put(task);
+    }
+    else {
+      // a closed tree over the whole search space leaves the engine nothing to search
+      exhausted = (task->depth==0 && timeFlag.load(memory_order_relaxed));
+      delete task;
+      if (exhausted) break;
+    }
+    if (runDeadline.expired()) timeFlag.store(false, memory_order_relaxed);
+  }
+  incumbent->publish(engine->bestNumUnsat, engine->best_soln);
+  
+  *numUnsat = engine->bestCost();
+}
+
+
+/* Thread body for the engines of a run */
+void runEngine(Engine *engine, unsigned long long *numUnsat) {
+  *numUnsat = engine->runUCTtimed();
+}
+
+
+/* Returns the number of variables in the input file */
+int numInputVars() {
+  return pp_enabled ? pp_orig_num_vars : num_vars;
+}
+
+
+/* Maps an assignment of the searched formula back to the variables of the input file */
+void mapSolution(int *soln, int *inputSoln) {
+  int v;
+  
+  // undo the renumbering first, then the preprocessing
+  if (rn_enabled) {
+    rn_restore(soln, renumberBuffer);
+    soln = renumberBuffer;
+  }
+  if (pp_enabled) {
+    pp_reconstruct(soln, inputSoln);
+  }
+  else {
+    for (v=1; v<=num_vars; v++) {
+      inputSoln[v] = soln[v];
+    }
+  }
+}
+
+
+bool trajectoryBefore(const trajectoryPoint &a, const trajectoryPoint &b) {
+  return a.time < b.time;
+}
+
+
+/* Merges the trajectories of the engines of a run into the anytime profile of the run: the
+ * improvements of any engine, in time order, that beat all earlier ones */
+vector<trajectoryPoint> mergeTrajectories(vector<Engine*> &runEngines) {
+  vector<trajectoryPoint> points, profile;
+  int k, j;
+  
+  for (k=0; k<(int)runEngines.size(); k++) {
+    points.insert(points.end(), runEngines[k]->trajectory.begin(), runEngines[k]->trajectory.end());
+  }
+  sort(points.begin(), points.end(), trajectoryBefore);
+  for (j=0; j<(int)points.size(); j++) {
+    if (profile.empty() || points[j].cost < profile.back().cost) {
+      profile.push_back(points[j]);
+    }
+  }
+  return profile;
+}
+
+
+/* Number of clauses of the searched formula that <soln> falsifies, only the hard ones if
+ * <hardOnly> is set */
+int countUnsat(const int *soln, int hardOnly) {
+  int c, j, count = 0;
+  for (c=0; c<num_clauses; c++) {
+    if (hardOnly && !is_hard(clause_weight[c])) continue;
+    for (j=clause_lit_start[c]; j<clause_lit_start[c+1]; j++) {
+      if (soln[lit_var(clause_lit[j])] == lit_sense(clause_lit[j])) break;
+    }
+    count += (j==clause_lit_start[c+1]);
+  }
+  return count;
+}
+
+
+/* Writes the record of run <run> to the -o results file: its result <numUnsat>, the best
+ * assignment <soln> of the run's engines with cost <cost>, the run's anytime profile and the
+ * counters of <runEngines>, then the parameters. */
+void writeResult(int run, unsigned long long numUnsat, unsigned long long cost, int *soln,
+                 vector<trajectoryPoint> &profile, vector<Engine*> &runEngines) {
+  unsigned long long iterations = 0, flips = 0, nodes = 0;
+  int k, depth = 0;
+  
+  for (k=0; k<(int)runEngines.size(); k++) {
+    iterations += runEngines[k]->iterations;
+    flips += runEngines[k]->flips;
+    nodes += runEngines[k]->nodes;
+    depth = max(depth, runEngines[k]->maxDepth);
+  }
+  
+  rs_begin();
+  rs_int("run", run);
+  rs_int("seed", masterSeed);
+  rs_int("cost", numUnsat);
+  if (cost!=NO_COST) {
+    rs_int("unsat_weight", cost + pp_cost_offset);
+    rs_int("unsat_clauses", countUnsat(soln, 0));
+  }
+  else {
+    rs_null("unsat_weight");
+    rs_null("unsat_clauses");
+  }
+  if (cost!=NO_COST && probtype==WEIGHTED_PARTIAL) {
+    rs_int("unsat_hard", countUnsat(soln, 1));
+  }
+  else {
+    rs_null("unsat_hard");
+  }
+  if (profile.empty()) {
+    rs_null("time_to_best");
+  }
+  else {
+    rs_double("time_to_best", profile.back().time);
+  }
+  rs_double("time", Deadline::now(0) - runStart);
+  rs_int("iterations", iterations);
+  rs_int("flips", flips);
+  rs_int("nodes", nodes);
+  rs_int("max_depth", depth);
+  rs_string("instance", filename);
+  rs_string("sls", evaluatorNames[evaluator]);
+  rs_double("c", C);
+  rs_double("noise", prob/((double) RAND_MAX_INT));
+  rs_int("max_flips", maxFlips);
+  if (deterministic) {
+    rs_null("timeout");
+  }
+  else {
+    rs_double("timeout", runTimeout);
+  }
+  rs_string("clock", cpuTimeout ? "cpu" : "wall");
+  rs_int("max_iterations", maxIterations);
+  rs_int("deterministic", deterministic);
+  rs_string("generator", legacyRandom ? "rand_r" : "xoshiro256**");
+  rs_int("threads", numThreads);
+  rs_int("portfolio", portfolio);
+  rs_int("cube_atoms", co_depth);
+  rs_int("preprocessing", simplify);
+  rs_int("renumbering", locality);
+  if (printModel) {
+    if (cost!=NO_COST) {
+      // the model takes the variables of the input file, which preprocessing may outnumber
+      vector<int> model(numInputVars()+1);
+      mapSolution(soln, model.data());
+      rs_model("model", model.data(), numInputVars());
+    }
+    else {
+      rs_null("model");
+    }
+  }
+  rs_end();
+}
+
+
+/* Performs UCT runs and prints the results to stdout. Each run searches with <numThreads>
+ * engines and reports the best of them. The engines are independent unless <portfolio> is
+ * set, in which case they run the configurations of <portfolioTable> and share an incumbent.
+ * If a cube depth is given, the engines instead schedule subtree tasks by work stealing. */
+void performRuns() {
+  int i, k;
+  int stealing = (co_depth>=0);
+  unsigned long long numUnsat[numRuns];
+  unsigned long long engineNumUnsat[numThreads];
+  unsigned long long runCost, bestRunNumUnsat = NO_COST;
+  vector< vector<trajectoryPoint> > profiles(numRuns);
+  vector<int> runSoln(num_vars+1);
+  vector<thread> workers;
+  
+  // the engines keep their best assignment from one run to the next
+  for (k=0; k<numThreads; k++) {
+    engines.push_back(new Engine(deterministic ? streamSeed(k) : rand()));
+    engines[k]->id = k;
+    if (portfolio && k>0) {
+      const portfolioEntry &e = portfolioTable[(k-1)%portfolioSize];
+      engines[k]->configure(e.evaluator, e.C, (int)(e.noise*RAND_MAX_INT), e.maxFlips);
+    }
+    else {
+      engines[k]->configure(evaluator, C, prob, maxFlips);
+    }
+  }
+  incumbent = new Incumbent();
+  epochBarrier = new EpochBarrier(numThreads);
+  epochCost.assign(numThreads, NO_COST);
+  
+  // with -k, the threads share the cubes over the first co_depth A0 atoms as subtree tasks
+  if (stealing) {
+    co_depth = min(co_depth, num_vars);
+    selectCubeAtoms(engines[0]);
+    for (k=0; k<numThreads; k++) {
+      engines[k]->cubeAtoms = co_atoms;
+      ws_deques.push_back(new ws_deque());
+    }
+  }
+  if (tr_file) {
+    tr_start(numThreads, stealing, C, pp_cost_offset);
+  }
   
   for (i=0; i<numRuns; i++) {
-    numUnsat[i] = runUCTtimed();
+    incumbent->reset();
+    tr_run = i;
+    timeFlag.store(true);
+    // a deterministic run ends after its iterations, the time it takes must not matter
+    if (deterministic) {
+      runDeadline.clear();
+    }
+    else {
+      runDeadline.set(runTimeout, cpuTimeout);
+    }
+    
+    runStart = Deadline::now(0);
+    STATS(peakTreeBytes = treeBytes.load());
+    
+    if (stealing) {
+      ws_task_ids = 0;
+      for (k=0; k<(1<<co_depth); k++) {
+        ws_deques[k%numThreads]->put(new ws_task(k, co_depth));
+      }
+      workers.clear();
+      for (k=0; k<numThreads; k++) {
+        workers.push_back(thread(runStealing, engines[k], k, &engineNumUnsat[k]));
+      }
+      for (k=0; k<numThreads; k++) {
+        workers[k].join();
+        ws_deques[k]->clear();
+      }
+    }
+    else if (numThreads==1) {
+      runEngine(engines[0], &engineNumUnsat[0]);
+    }
+    else {
+      workers.clear();
+      for (k=0; k<numThreads; k++) {
+        workers.push_back(thread(runEngine, engines[k], &engineNumUnsat[k]));
+      }
+      for (k=0; k<numThreads; k++) {
+        workers[k].join();
+      }
+    }
+    
+    numUnsat[i] = engineNumUnsat[0];
+    for (k=0; k<numThreads; k++) {
+      numUnsat[i] = min(numUnsat[i], engineNumUnsat[k]);
+    }
+    profiles[i] = mergeTrajectories(engines);
+#ifdef UCT_STATS
+    uctStats runStats;
+    unsigned long long runFlips = 0, runIterations = 0, runNodes = 0;
+    char label[32];
+    for (k=0; k<numThreads; k++) {
+      runStats.add(engines[k]->stats);
+      runFlips += engines[k]->flips;
+      runIterations += engines[k]->iterations;
+      runNodes += engines[k]->nodes;
+    }
+    sprintf(label, "Stats run %d", i);
+    printStats(label, runStats, runFlips, runIterations, runNodes, Deadline::now(0) - runStart);
+#endif
+    // engines may tie, so a deterministic run takes the first best engine rather than the
+    // one that happened to publish first
+    runCost = NO_COST;
+    if (deterministic) {
+      for (k=0; k<numThreads; k++) {
+        if (engines[k]->bestNumUnsat < runCost) {
+          runCost = engines[k]->bestNumUnsat;
+          memcpy(runSoln.data(), engines[k]->best_soln, (num_vars+1)*sizeof(int));
+        }
+      }
+    }
+    // every engine has published its best assignment, and no writer is left
+    else if (!incumbent->snapshot(runCost, runSoln.data())) {
+      runCost = NO_COST;
+    }
+    if (runCost < bestRunNumUnsat) {
+      bestRunNumUnsat = runCost;
+      mapSolution(runSoln.data(), bestModel);
+    }
+    if (rs_file) {
+      writeResult(i, numUnsat[i], runCost, runSoln.data(), profiles[i], engines);
+    }
+  }
+  
+  if (tr_file) {
+    tr_finish();
+  }
+  for (k=0; k<numThreads; k++) {
+    delete engines[k];
+  }
+  engines.clear();
+  delete epochBarrier;
+  for (k=0; k<(int)ws_deques.size(); k++) {
+    delete ws_deques[k];
   }
+  delete incumbent;
   
   /* print results to stdout */
   printf("\n*** Best Num Unsat ***\n");
   for (i=0; i<numRuns; i++) {
-    printf("Run %d: %d\n", i, numUnsat[i]);
+    printf("Run %d: %llu\n", i, numUnsat[i]);
   }
   printf("\n");
+  if (printTrajectory) {
+    printf("*** Anytime Profile (time iteration nodes flips unsat) ***\n");
+    for (i=0; i<numRuns; i++) {
+      for (k=0; k<(int)profiles[i].size(); k++) {
+        printf("Run %d: %f %llu %llu %llu %llu\n", i, profiles[i][k].time, profiles[i][k].iteration,
+               profiles[i][k].nodes, profiles[i][k].flips, profiles[i][k].cost);
+      }
+    }
+    printf("\n");
+  }
   printParams();
+  if (printModel) {
+    print_solution(bestModel, numInputVars());
+  }
+}
+
+
+/* Body of a worker process: searches the cubes the coordinator sends until it says stop */
+void runWorker(int sock, unsigned int seed) {
+  co_message msg;
+  Engine *engine = new Engine(seed);
+  unsigned long long numUnsat;
+  
+  co_socket = sock;
+  incumbent = new Incumbent();
+  engine->configure(evaluator, C, prob, maxFlips);
+  engine->cubeAtoms = co_atoms;
+  engine->cubeSize = co_depth;
+  
+  // a cube comes with the global best assignment, which seeds the playouts outside the cube's atoms
+  while (co_receive(sock, msg, engine->best_soln) && msg.type!=CO_STOP) {
+    if (msg.type!=CO_CUBE) continue;
+    engine->cube = msg.cube;
+    co_global_best = msg.cost;
+    co_reported = NO_COST;
+    incumbent->reset();
+    
+    timeFlag.store(true);
+    runStart = Deadline::now(0);
+    runDeadline.set(runTimeout, cpuTimeout);
+    numUnsat = engine->runUCTtimed();
+    if (!co_send(sock, CO_DONE, msg.cube, numUnsat, engine->bestNumUnsat, engine->best_soln)) break;
+  }
+  _exit(0);
+}
+
+
+/* Coordinator mode: searches each cube for <runTimeout> seconds on <co_workers> worker
+ * processes and prints the results to stdout. A worker that finishes a cube gets the next
+ * unassigned one, together with the global best assignment, and every improvement of the
+ * global best is broadcast to the busy workers. The cube of a worker that dies is handed
+ * to another worker. */
+void coordinate() {
+  int i, k, cube, numCubes, numDone;
+  int alive, improved;
+  co_message msg;
+  unsigned long long globalBest = NO_COST; // best cost reported by any worker
+  unsigned long long solnCost = NO_COST; // cost of <globalSoln>, the best finished assignment
+  int *globalSoln = new int[num_vars+1];
+  int *workerSoln = new int[num_vars+1];
+  vector<int> sockets(co_workers), workerCube(co_workers, -1);
+  vector<pid_t> pids(co_workers);
+  vector<int> pending;
+  vector<struct pollfd> fds(co_workers);
+  Engine *engine = new Engine(rand());
+  
+  if (co_depth<0) co_depth = co_default_depth();
+  co_depth = min(co_depth, min(CO_MAX_DEPTH, num_vars));
+  selectCubeAtoms(engine);
+  delete engine;
+  
+  numCubes = 1<<co_depth;
+  vector<unsigned long long> cubeNumUnsat(numCubes, NO_COST);
+  for (cube=numCubes-1; cube>=0; cube--) {
+    pending.push_back(cube);
+  }
+  
+  // fork the workers, each with its own socket pair
+  fflush(stdout);
+  signal(SIGPIPE, SIG_IGN);
+  for (k=0; k<co_workers; k++) {
+    int pair[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair)<0) {
+      perror("socketpair");
+      exit(1);
+    }
+    unsigned int seed = rand();
+    pids[k] = fork();
+    if (pids[k]<0) {
+      perror("fork");
+      exit(1);
+    }
+    if (pids[k]==0) {
+      for (i=0; i<k; i++) close(sockets[i]);
+      close(pair[0]);
+      runWorker(pair[1], seed);
+    }
+    close(pair[1]);
+    sockets[k] = pair[0];
+  }
+  
+  alive = co_workers;
+  for (k=0; k<co_workers; k++) {
+    if (!pending.empty()) {
+      workerCube[k] = pending.back();
+      pending.pop_back();
+      co_send(sockets[k], CO_CUBE, workerCube[k], 0, solnCost, globalSoln);
+    }
+    else {
+      co_send(sockets[k], CO_STOP, 0, 0, 0, NULL);
+    }
+  }
+  
+  numDone = 0;
+  while (numDone<numCubes && alive>0) {
+    for (k=0; k<co_workers; k++) {
+      fds[k].fd = sockets[k];
+      fds[k].events = POLLIN;
+    }
+    if (poll(fds.data(), co_workers, -1)<0) {
+      if (errno==EINTR) continue;
+      perror("poll");
+      exit(1);
+    }
+    
+    for (k=0; k<co_workers; k++) {
+      if (sockets[k]<0 || !(fds[k].revents & (POLLIN|POLLHUP|POLLERR))) continue;
+      
+      if (!co_receive(sockets[k], msg, workerSoln)) {
+        // the worker is gone, hand its cube to someone else
+        close(sockets[k]);
+        sockets[k] = -1;
+        alive--;
+        if (workerCube[k]>=0) {
+          pending.push_back(workerCube[k]);
+          workerCube[k] = -1;
+        }
+        continue;
+      }
+      
+      improved = msg.cost<globalBest;
+      globalBest = min(globalBest, msg.cost);
+      if (msg.type==CO_DONE) {
+        cubeNumUnsat[msg.cube] = msg.num_unsat;
+        workerCube[k] = -1;
+        numDone++;
+        if (msg.cost<solnCost) {
+          solnCost = msg.cost;
+          memcpy(globalSoln, workerSoln, (num_vars+1)*sizeof(int));
+        }
+        if (!pending.empty()) {
+          workerCube[k] = pending.back();
+          pending.pop_back();
+          co_send(sockets[k], CO_CUBE, workerCube[k], 0, solnCost, globalSoln);
+        }
+        else {
+          co_send(sockets[k], CO_STOP, 0, 0, 0, NULL);
+        }
+      }
+      
+      // broadcast an improved global best to the busy workers
+      for (i=0; improved && i<co_workers; i++) {
+        if (i!=k && sockets[i]>=0 && workerCube[i]>=0) {
+          co_send(sockets[i], CO_BEST, 0, 0, globalBest, NULL);
+        }
+      }
+    }
+  }
+  
+  for (k=0; k<co_workers; k++) {
+    if (sockets[k]>=0) close(sockets[k]);
+    waitpid(pids[k], NULL, 0);
+  }
+  if (numDone<numCubes) {
+    printf("c All workers died with %d cubes left\n", numCubes-numDone);
+  }
+  if (solnCost!=NO_COST) {
+    mapSolution(globalSoln, bestModel);
+  }
+  
+  /* print results to stdout */
+  printf("\n*** Best Num Unsat ***\n");
+  for (cube=0; cube<numCubes; cube++) {
+    // a cube no worker finished prints as -1
+    printf("Cube %d: %lld\n", cube, (long long)cubeNumUnsat[cube]);
+  }
+  if (globalBest!=NO_COST) {
+    printf("Best: %llu\n", globalBest + pp_cost_offset);
+  }
+  printf("\n");
+  printParams();
+  printf("Workers: %d\n", co_workers);
+  printf("Cube atoms: %d\n", co_depth);
+  if (printModel) {
+    print_solution(bestModel, numInputVars());
+  }
+  
+  delete[] globalSoln;
+  delete[] workerSoln;
 }
 
 
@@ -456,11 +1407,30 @@ void printParams() {
   printf("UCT runs: %d\n", numRuns);
   printf("UCT C param: %f\n", C);
   printf("UCT branching heuristic: A0\n");
-  printf("SLS algorithm: CCLS14\n");
+  printf("SLS algorithm: %s\n", evaluatorNames[evaluator]);
   printf("SLS max flips: %d\n", maxFlips);
   printf("SLS noise param: %f\n", prob/((double) RAND_MAX_INT));
+  if (probtype==WEIGHTED_PARTIAL) {
+    printf("Top weight: %d\n", hard_clause_weight);
+  }
   printf("Bandit Algorithm: UCB1\n");
-  printf("Timeout: %d\n", runTimeout);
+  if (deterministic) {
+    printf("Timeout: NA\n");
+    printf("Deterministic: seed %u\n", masterSeed);
+  }
+  else {
+    printf("Timeout: %g (%s time)\n", runTimeout, cpuTimeout ? "cpu" : "wall");
+  }
+  if (maxIterations) {
+    printf("UCT iterations per run: %d\n", maxIterations);
+  }
+  printf("Random generator: %s\n", legacyRandom ? "rand_r" : "xoshiro256**");
+  printf("Threads: %d\n", numThreads);
+  printf("Portfolio: %s\n", portfolio ? "on" : "off");
+  printf("Preprocessing: %s\n", simplify ? "on" : "off");
+  printf("Renumbering: %s\n", locality ? "on" : "off");
+  STATS(printf("Stats interval: %g\n", statsInterval));
+  STATS(printf("Hardware counters: %s\n", hw_enabled ? "on" : "off"));
   fflush(stdout);
 }
 
@@ -472,26 +1442,33 @@ void printMemoryError() {
 }
 
 
-/* Handles timeout signals */
-void ALARMhandler(int sig)
-{
-  timeFlag = 0;
-  bestRewardAtTimeout = bestReward;
-  signal(SIGALRM, SIG_IGN);
-}
-
-
 void printUsageError() {
-  printf("Usage: uct -f filename [-r INT] [-i INT] [-c DOUBLE] [-p DOUBLE] [-m INT] ");
-  printf("[-n DOUBLE] [-o INT] [-t INT]\n");
+  printf("Usage: uct -f filename [-r INT] [-i INT] [-c DOUBLE] [-a INT] [-m INT] ");
+  printf("[-n DOUBLE] [-o FILE] [-t DOUBLE] [-u] [-j INT] [-p] [-w INT] [-k INT] [-d INT] [-g] [-s] [-l] [-v] [-y] [-e DOUBLE] [-x] [-z FILE]\n");
   printf("-flag : <description> (= <default value>)\n");
   printf("-f : .cnf filename \n");
   printf("-r : number of uct runs (=10) \n");
-  printf("-i : maximum number of uct iterations per run (=2000) \n");
+  printf("-i : maximum number of uct iterations per run and engine (no limit, 2000 with -d) \n");
   printf("-c : UCT exploration/exploitation parameter (=0.02) \n");
+  printf("-a : sls algorithm, 0 = CCLS, 1 = WalkSAT, 2 = Novelty (=0) \n");
   printf("-m : max flips for each sls run (=1000) \n");
   printf("-n : noise param for each sls run (=0.0) \n");
-  printf("-t : run timeout in seconds (15)\n\n");
+  printf("-t : run timeout in seconds, fractions allowed (15)\n");
+  printf("-u : measure the run timeout in process cpu time instead of wall time (off)\n");
+  printf("-j : number of engines searching concurrently in each run (1)\n");
+  printf("-p : run a portfolio of sls algorithms and parameters across the engines (off)\n");
+  printf("-w : number of worker processes, each cube is then searched once for the run timeout (0)\n");
+  printf("-k : number of fixed atoms per cube; without -w, the threads steal cubes as subtree tasks (off)\n");
+  printf("-d : deterministic mode with the given master seed, runs end after -i iterations (off)\n");
+  printf("-g : draw random numbers from rand_r() with modulo reduction instead of xoshiro256** (off)\n");
+  printf("-s : simplify the formula before search (off)\n");
+  printf("-l : renumber variables and clauses for memory locality (off)\n");
+  printf("-v : print the best assignment found (off)\n");
+  printf("-y : print the anytime profile of each run, every improvement with its time (off)\n");
+  printf("-e : seconds between reports of the UCT counters of each engine, builds with -DUCT_STATS only (off)\n");
+  printf("-x : count cycles, instructions, cache and branch misses of each UCT phase with perf_event, builds with -DUCT_STATS only (off)\n");
+  printf("-z : write a binary trace of every UCT iteration to the given file, see trace_replay.cpp (off)\n");
+  printf("-o : write one JSON object per run to the given file, CSV rows if its name ends in .csv (off)\n\n");
   fflush(stdout);
   exit(1);
 }
@@ -506,7 +1483,7 @@ int main(int argc, char* argv[])
     int i, option;
     int fflag = 1;
 	
-	while ((option = getopt(argc, argv, "f:c:m:r:n:t:")) != -1) {
+	while ((option = getopt(argc, argv, "f:c:a:m:r:i:n:t:uj:pw:k:d:gslvye:o:xz:")) != -1) {
     
       switch (option) {
       
@@ -521,24 +1498,107 @@ int main(int argc, char* argv[])
           break;
           
         case 't':
-          runTimeout = atoi(optarg);
+          runTimeout = atof(optarg);
+          break;
+        
+        case 'u':
+          cpuTimeout = 1;
           break;
 
         case 'r':
           numRuns = atoi(optarg);
           break;
+        
+        case 'i':
+          maxIterations = max(0, atoi(optarg));
+          break;
+        
+        case 'd':
+          deterministic = 1;
+          masterSeed = strtoul(optarg, NULL, 10);
+          break;
           
         case 'c':
           C = atof(optarg);
           break;
         
         case 'n':
-          prob = (int) atof(optarg)*RAND_MAX_INT;
+          prob = (int) (atof(optarg)*RAND_MAX_INT);
+          break;
+        
+        case 'a':
+          evaluator = atoi(optarg);
+          if (evaluator<CCLS || evaluator>NOVELTY) {
+            printf("\nFatal Error: sls algorithm %d is invalid!\n", evaluator);
+            printUsageError();
+          }
           break;
         
         case 'm':
           maxFlips = atoi(optarg);
           break;
+        
+        case 'j':
+          numThreads = max(1, atoi(optarg));
+          break;
+        
+        case 'p':
+          portfolio = 1;
+          break;
+        
+        case 'w':
+          co_workers = max(0, atoi(optarg));
+          break;
+        
+        case 'k':
+          co_depth = min(max(0, atoi(optarg)), CO_MAX_DEPTH);
+          break;
+        
+        case 'g':
+          legacyRandom = 1;
+          break;
+        
+        case 's':
+          simplify = 1;
+          break;
+        
+        case 'l':
+          locality = 1;
+          break;
+        
+        case 'v':
+          printModel = 1;
+          break;
+        
+        case 'y':
+          printTrajectory = 1;
+          break;
+        
+        case 'e':
+          statsInterval = atof(optarg);
+          break;
+        
+        case 'x':
+          hw_enabled = 1;
+          break;
+        
+        case 'z':
+          tr_file = fopen(optarg, "wb");
+          if (!tr_file) {
+            printf("c Cannot open trace file: %s\n", optarg);
+            fflush(stdout);
+            return -1;
+          }
+          setvbuf(tr_file, NULL, _IOFBF, TR_BUFFER);
+          break;
+        
+        case 'o':
+          if (rs_open(optarg)==0) {
+            printf("c Cannot open results file: %s\n", optarg);
+            fflush(stdout);
+            return -1;
+          }
+          break;
       	
         case '?':
           if (optopt == 'c')
@@ -553,21 +1613,50 @@ int main(int argc, char* argv[])
       }  
     }
 	
-	probtype = NONE;
-    
     if (fflag) {
       printf("Fatal Error: filename must be specified!\n");
       printUsageError();
     }
+    
+    if (simplify) {
+      preprocess();
+    }
+    if (locality) {
+      renumber();
+    }
+    build_neighbor_relation();
 	
-    seed = time(0);
+    if ((rs_file || tr_file) && co_workers>0) {
+      printf("Fatal Error: -o and -z cannot be combined with -w!\n");
+      printUsageError();
+    }
+    if (deterministic) {
+      if (co_workers>0 || co_depth>=0) {
+        printf("Fatal Error: deterministic mode cannot be combined with -w or -k!\n");
+        printUsageError();
+      }
+      if (maxIterations==0) {
+        maxIterations = 2000;
+      }
+      seed = masterSeed;
+    }
+    else {
+      seed = time(0);
+      masterSeed = seed;
+    }
 	srand(seed);
 	
-    bestVars = new int[num_vars];
-    varScores = new int[num_vars];
+    renumberBuffer = new int[num_vars+1];
+    bestModel = new int[numInputVars()+1];
     
 	// Perform UCT
-	performRuns();
+	if (co_workers>0) {
+	  coordinate();
+	}
+	else {
+	  performRuns();
+	}
+	rs_close();
 	 
 	free_memory();
 
@@ -0,0 +1,419 @@
+/* MaxSAT preprocessing for the CCLS driver
+ *
+ * Simplifies the formula loaded by build_instance() into a smaller weighted formula with
+ * the same optimum, and keeps the reconstruction map needed to turn a solution of the
+ * reduced formula back into a solution of the original one:
+ *   - duplicate clauses are merged into a single clause with the summed weight
+ *   - complementary unit soft clauses (x,w1) (-x,w2) are resolved, moving min(w1,w2)
+ *     into <pp_cost_offset>
+ *   - pure literals are fixed, which satisfies every clause they appear in
+ *   - clauses subsumed by a hard clause are removed
+ *   - variables occurring only in hard clauses are eliminated by bounded resolution
+ * Variables that no longer occur are dropped and the remaining ones are renumbered
+ * densely, so the UCT tree branches only on variables that still matter.
+ */
+
+#include <algorithm>
+
+#define PP_MAX_ROUNDS 10  // maximum number of passes over the simplification rules
+#define PP_MAX_ELIM_OCC 16 // variables with more occurrences are never eliminated
+
+struct pp_clause {
+	vector<int>		lits;		//DIMACS literals, sorted by variable
+	int				weight;
+	int				removed;
+};
+
+vector<pp_clause> pp_clauses;
+vector< vector<int> > pp_occ;			//pp_occ[pp_lit_index(l)] lists the clauses containing l
+vector< vector<int> > pp_elim;			//removed clauses of eliminated variables, pivot literal first
+
+int		pp_enabled = 0;
+int		pp_orig_num_vars;
+int*	pp_var_orig;					//pp_var_orig[v] is the original index of reduced variable v
+int*	pp_fixed;						//pp_fixed[v] is the value of original variable v fixed by preprocessing, or -1
+unsigned long long pp_cost_offset = 0ll;	//weight falsified by every assignment of the original formula
+
+int		pp_num_merged, pp_num_pure, pp_num_subsumed, pp_num_elim, pp_num_units;
+
+
+inline int pp_lit_index(int l)
+{
+	return (abs(l)<<1)|(l>0);
+}
+
+bool pp_lit_less(int a, int b)
+{
+	return abs(a)<abs(b) || (abs(a)==abs(b) && a<b);
+}
+
+bool pp_clause_less(int a, int b)
+{
+	return pp_clauses[a].lits < pp_clauses[b].lits;
+}
+
+void pp_remove_clause(int c)
+{
+	pp_clauses[c].removed = 1;
+}
+
+void pp_build_occ()
+{
+	int c,j;
+	pp_occ.assign(2*(pp_orig_num_vars+1), vector<int>());
+	for (c=0; c<(int)pp_clauses.size(); ++c)
+	{
+		if (pp_clauses[c].removed) continue;
+		for (j=0; j<(int)pp_clauses[c].lits.size(); ++j)
+			pp_occ[pp_lit_index(pp_clauses[c].lits[j])].push_back(c);
+	}
+}
+
+int pp_add_clause(vector<int>& lits, int weight)
+{
+	pp_clause cl;
+	int j, c = pp_clauses.size();
+	cl.lits = lits;
+	cl.weight = weight;
+	cl.removed = 0;
+	pp_clauses.push_back(cl);
+	for (j=0; j<(int)lits.size(); ++j)
+		pp_occ[pp_lit_index(lits[j])].push_back(c);
+	return c;
+}
+
+
+/* merges identical clauses into one clause carrying the summed weight */
+int pp_merge_duplicates()
+{
+	int i, a, b, changed = 0;
+	vector<int> order;
+
+	for (i=0; i<(int)pp_clauses.size(); ++i)
+		if (!pp_clauses[i].removed) order.push_back(i);
+	sort(order.begin(), order.end(), pp_clause_less);
+
+	for (i=1; i<(int)order.size(); ++i)
+	{
+		a = order[i-1];
+		b = order[i];
+		if (pp_clauses[a].lits != pp_clauses[b].lits) continue;
+		if (is_hard(pp_clauses[a].weight) || is_hard(pp_clauses[b].weight))
+			pp_clauses[b].weight = hard_clause_weight;
+		else pp_clauses[b].weight += pp_clauses[a].weight;
+		pp_remove_clause(a);
+		pp_num_merged++;
+		changed = 1;
+	}
+	return changed;
+}
+
+
+/* resolves complementary unit clauses, moving the weight that can never be satisfied into
+ * <pp_cost_offset> */
+int pp_resolve_units()
+{
+	int c, v, pos, neg, w, changed = 0;
+	vector<int> unit_pos(pp_orig_num_vars+1, -1), unit_neg(pp_orig_num_vars+1, -1);
+
+	for (c=0; c<(int)pp_clauses.size(); ++c)
+	{
+		if (pp_clauses[c].removed || pp_clauses[c].lits.size()!=1) continue;
+		if (pp_clauses[c].lits[0]>0) unit_pos[pp_clauses[c].lits[0]] = c;
+		else unit_neg[-pp_clauses[c].lits[0]] = c;
+	}
+
+	for (v=1; v<=pp_orig_num_vars; ++v)
+	{
+		pos = unit_pos[v];
+		neg = unit_neg[v];
+		if (pos<0 || neg<0) continue;
+		if (is_hard(pp_clauses[pos].weight) && is_hard(pp_clauses[neg].weight)) continue;
+
+		if (is_hard(pp_clauses[pos].weight)) w = pp_clauses[neg].weight;
+		else if (is_hard(pp_clauses[neg].weight)) w = pp_clauses[pos].weight;
+		else w = min(pp_clauses[pos].weight, pp_clauses[neg].weight);
+
+		pp_cost_offset += w;
+		if (!is_hard(pp_clauses[pos].weight) && (pp_clauses[pos].weight -= w)==0) pp_remove_clause(pos);
+		if (!is_hard(pp_clauses[neg].weight) && (pp_clauses[neg].weight -= w)==0) pp_remove_clause(neg);
+		pp_num_units++;
+		changed = 1;
+	}
+	return changed;
+}
+
+
+/* fixes variables that occur in only one polarity, removing the clauses they satisfy */
+int pp_fix_pure_literals()
+{
+	int v, l, i, changed = 0;
+	int num_pos, num_neg;
+
+	pp_build_occ();
+	for (v=1; v<=pp_orig_num_vars; ++v)
+	{
+		if (pp_fixed[v]!=-1) continue;
+		num_pos = num_neg = 0;
+		for (i=0; i<(int)pp_occ[pp_lit_index(v)].size(); ++i)
+			if (!pp_clauses[pp_occ[pp_lit_index(v)][i]].removed) num_pos++;
+		for (i=0; i<(int)pp_occ[pp_lit_index(-v)].size(); ++i)
+			if (!pp_clauses[pp_occ[pp_lit_index(-v)][i]].removed) num_neg++;
+		if ((num_pos==0) == (num_neg==0)) continue;
+
+		l = num_pos ? v : -v;
+		pp_fixed[v] = (l>0);
+		for (i=0; i<(int)pp_occ[pp_lit_index(l)].size(); ++i)
+			pp_remove_clause(pp_occ[pp_lit_index(l)][i]);
+		pp_num_pure++;
+		changed = 1;
+	}
+	return changed;
+}
+
+
+/* removes every clause that is a superset of a hard clause */
+int pp_remove_subsumed()
+{
+	int c, d, i, j, best, changed = 0;
+	vector<char> mark(2*(pp_orig_num_vars+1), 0);
+
+	pp_build_occ();
+	for (c=0; c<(int)pp_clauses.size(); ++c)
+	{
+		if (pp_clauses[c].removed || !is_hard(pp_clauses[c].weight)) continue;
+		vector<int>& lits = pp_clauses[c].lits;
+		if (lits.empty()) continue;
+
+		// only clauses containing the rarest literal of c can be subsumed by c
+		best = pp_lit_index(lits[0]);
+		for (j=1; j<(int)lits.size(); ++j)
+			if (pp_occ[pp_lit_index(lits[j])].size() < pp_occ[best].size())
+				best = pp_lit_index(lits[j]);
+
+		for (j=0; j<(int)lits.size(); ++j) mark[pp_lit_index(lits[j])] = 1;
+		for (i=0; i<(int)pp_occ[best].size(); ++i)
+		{
+			d = pp_occ[best][i];
+			if (d==c || pp_clauses[d].removed || pp_clauses[d].lits.size()<lits.size()) continue;
+			int found = 0;
+			for (j=0; j<(int)pp_clauses[d].lits.size(); ++j)
+				found += mark[pp_lit_index(pp_clauses[d].lits[j])];
+			if (found==(int)lits.size())
+			{
+				pp_remove_clause(d);
+				pp_num_subsumed++;
+				changed = 1;
+			}
+		}
+		for (j=0; j<(int)lits.size(); ++j) mark[pp_lit_index(lits[j])] = 0;
+	}
+	return changed;
+}
+
+
+/* resolves <a> and <b> on variable <v>, returns 0 if the resolvent is a tautology */
+int pp_resolve(vector<int>& a, vector<int>& b, int v, vector<int>& out)
+{
+	int i, j;
+	out.clear();
+	for (i=0; i<(int)a.size(); ++i)
+		if (abs(a[i])!=v) out.push_back(a[i]);
+	for (j=0; j<(int)b.size(); ++j)
+	{
+		if (abs(b[j])==v) continue;
+		for (i=0; i<(int)out.size(); ++i)
+			if (abs(out[i])==abs(b[j])) break;
+		if (i==(int)out.size()) out.push_back(b[j]);
+		else if (out[i]!=b[j]) return 0;
+	}
+	sort(out.begin(), out.end(), pp_lit_less);
+	return 1;
+}
+
+
+/* bounded variable elimination, restricted to variables that occur only in hard clauses so
+ * that the soft part of the objective is left untouched */
+int pp_eliminate_variables()
+{
+	int v, i, j, c, changed = 0;
+	vector<int> pos, neg, res;
+	vector< vector<int> > resolvents;
+
+	pp_build_occ();
+	for (v=1; v<=pp_orig_num_vars; ++v)
+	{
+		if (pp_fixed[v]!=-1) continue;
+		pos.clear();
+		neg.clear();
+		int soft = 0;
+		for (i=0; i<(int)pp_occ[pp_lit_index(v)].size() && !soft; ++i)
+		{
+			c = pp_occ[pp_lit_index(v)][i];
+			if (pp_clauses[c].removed) continue;
+			soft = !is_hard(pp_clauses[c].weight);
+			pos.push_back(c);
+		}
+		for (i=0; i<(int)pp_occ[pp_lit_index(-v)].size() && !soft; ++i)
+		{
+			c = pp_occ[pp_lit_index(-v)][i];
+			if (pp_clauses[c].removed) continue;
+			soft = !is_hard(pp_clauses[c].weight);
+			neg.push_back(c);
+		}
+		if (soft || pos.empty() || neg.empty()) continue;
+		if ((int)(pos.size()+neg.size()) > PP_MAX_ELIM_OCC) continue;
+
+		// only eliminate if the formula does not grow
+		resolvents.clear();
+		for (i=0; i<(int)pos.size(); ++i)
+		{
+			for (j=0; j<(int)neg.size(); ++j)
+			{
+				if (!pp_resolve(pp_clauses[pos[i]].lits, pp_clauses[neg[j]].lits, v, res)) continue;
+				if ((int)res.size() > MAX_CLAUSE_LEN) break;
+				resolvents.push_back(res);
+			}
+			if (j<(int)neg.size()) break;
+		}
+		if (i<(int)pos.size() || resolvents.size() > pos.size()+neg.size()) continue;
+
+		// keep the removed clauses for reconstruction, pivot literal first
+		for (i=0; i<(int)pos.size(); ++i)
+		{
+			res = pp_clauses[pos[i]].lits;
+			res.insert(res.begin(), v);
+			pp_elim.push_back(res);
+			pp_remove_clause(pos[i]);
+		}
+		for (i=0; i<(int)neg.size(); ++i)
+		{
+			res = pp_clauses[neg[i]].lits;
+			res.insert(res.begin(), -v);
+			pp_elim.push_back(res);
+			pp_remove_clause(neg[i]);
+		}
+		for (i=0; i<(int)resolvents.size(); ++i)
+			pp_add_clause(resolvents[i], hard_clause_weight);
+
+		pp_fixed[v] = 0; // placeholder, overwritten when the solution is reconstructed
+		pp_num_elim++;
+		changed = 1;
+	}
+	return changed;
+}
+
+
+/* Replaces the loaded formula with its simplified version */
+void preprocess()
+{
+	int c, i, v, round, changed;
+	int orig_num_clauses = num_clauses;
+	vector<int> new_index;
+
+	pp_orig_num_vars = num_vars;
+	pp_fixed = new int[num_vars+1];
+	for (v=0; v<=num_vars; ++v) pp_fixed[v] = -1;
+	pp_num_merged = pp_num_pure = pp_num_subsumed = pp_num_elim = pp_num_units = 0;
+
+	// copy the formula out of the CSR arrays
+	pp_clauses.resize(num_clauses);
+	for (c=0; c<num_clauses; ++c)
+	{
+		pp_clauses[c].weight = clause_weight[c];
+		pp_clauses[c].removed = 0;
+		for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; ++i)
+			pp_clauses[c].lits.push_back(lit_sense(clause_lit[i]) ? lit_var(clause_lit[i]) : -lit_var(clause_lit[i]));
+		sort(pp_clauses[c].lits.begin(), pp_clauses[c].lits.end(), pp_lit_less);
+	}
+	delete[] clause_lit;
+	delete[] clause_lit_start;
+	delete[] var_lit;
+	delete[] var_lit_start;
+
+	for (round=0; round<PP_MAX_ROUNDS; ++round)
+	{
+		changed = pp_merge_duplicates();
+		changed |= pp_resolve_units();
+		changed |= pp_fix_pure_literals();
+		changed |= pp_remove_subsumed();
+		changed |= pp_eliminate_variables();
+		if (!changed) break;
+	}
+	vector< vector<int> >().swap(pp_occ);
+
+	// renumber the variables that still occur densely from 1
+	new_index.assign(pp_orig_num_vars+1, 0);
+	for (c=0; c<(int)pp_clauses.size(); ++c)
+	{
+		if (pp_clauses[c].removed) continue;
+		for (i=0; i<(int)pp_clauses[c].lits.size(); ++i)
+			new_index[abs(pp_clauses[c].lits[i])] = 1;
+	}
+	num_vars = 0;
+	pp_var_orig = new int[pp_orig_num_vars+1];
+	for (v=1; v<=pp_orig_num_vars; ++v)
+	{
+		if (!new_index[v]) continue;
+		new_index[v] = ++num_vars;
+		pp_var_orig[num_vars] = v;
+	}
+
+	// and rebuild the instance from the remaining clauses
+	num_clauses = 0;
+	total_clause_weight = 0ll;
+	total_soft_weight = 0ll;
+	maxi_clause_len = -1;
+	mini_clause_len = num_vars+1;
+	maxi_clause_weight = -1;
+	mini_clause_weight = -1;
+	for (c=0; c<(int)pp_clauses.size(); ++c)
+	{
+		if (pp_clauses[c].removed) continue;
+		vector<int>& lits = pp_clauses[c].lits;
+		for (i=0; i<(int)lits.size(); ++i)
+			lit_buffer.push_back(make_lit(new_index[abs(lits[i])], lits[i]>0));
+		clause_lit_count[num_clauses] = lits.size();
+		clause_weight[num_clauses] = pp_clauses[c].weight;
+		total_clause_weight += (unsigned long long)pp_clauses[c].weight;
+		if (!is_hard(pp_clauses[c].weight)) total_soft_weight += (unsigned long long)pp_clauses[c].weight;
+		if (pp_clauses[c].weight!=1 && probtype==UNWEIGHTED) probtype = WEIGHTED;
+
+		maxi_clause_len = max(maxi_clause_len, (int)lits.size());
+		mini_clause_len = min(mini_clause_len, (int)lits.size());
+		if (maxi_clause_weight==-1 || pp_clauses[c].weight>maxi_clause_weight) maxi_clause_weight = pp_clauses[c].weight;
+		if (mini_clause_weight==-1 || pp_clauses[c].weight<mini_clause_weight) mini_clause_weight = pp_clauses[c].weight;
+		num_clauses++;
+	}
+	vector<pp_clause>().swap(pp_clauses);
+	build_literal_arrays();
+	pp_enabled = 1;
+
+	printf("c preprocessing: %d -> %d vars, %d -> %d clauses\n", pp_orig_num_vars, num_vars, orig_num_clauses, num_clauses);
+	printf("c   merged %d, pure %d, subsumed %d, eliminated %d, unit pairs %d, cost offset %llu\n",
+		pp_num_merged, pp_num_pure, pp_num_subsumed, pp_num_elim, pp_num_units, pp_cost_offset);
+	fflush(stdout);
+}
+
+
+/* Maps the assignment <soln> of the reduced formula to the assignment <orig_soln> of the
+ * original formula */
+void pp_reconstruct(int* soln, int* orig_soln)
+{
+	int v, i, j, sat;
+
+	for (v=1; v<=pp_orig_num_vars; ++v)
+		orig_soln[v] = (pp_fixed[v]==-1) ? 0 : pp_fixed[v];
+	for (v=1; v<=num_vars; ++v)
+		orig_soln[pp_var_orig[v]] = soln[v];
+
+	// eliminated variables are set in reverse order to satisfy their removed clauses
+	for (i=(int)pp_elim.size()-1; i>=0; --i)
+	{
+		vector<int>& cl = pp_elim[i];
+		sat = 0;
+		for (j=1; j<(int)cl.size() && !sat; ++j)
+			sat = (orig_soln[abs(cl[j])] == (cl[j]>0));
+		if (!sat) orig_soln[abs(cl[0])] = (cl[0]>0);
+	}
+}
@@ -0,0 +1,141 @@
+/* Locality-improving renumbering for the CCLS driver
+ *
+ * Variables are renumbered in reverse Cuthill-McKee order over the graph in which two
+ * variables are adjacent if they share a clause (the <var_neighbor> relation), and clauses
+ * are then sorted by their smallest new variable index. Variables that flip() touches
+ * together end up close together in <score>, <cur_soln> and the CSR literal arrays.
+ * <rn_var_orig> maps the new variable indices back for output.
+ */
+
+int		rn_enabled = 0;
+int*	rn_var_orig;		//rn_var_orig[v] is the index variable v had before renumbering
+
+vector<int> rn_clause_key;		//smallest new variable index of each clause, used for sorting
+
+
+bool rn_var_less(int a, int b)
+{
+	return var_lit_count[a] < var_lit_count[b] || (var_lit_count[a]==var_lit_count[b] && a<b);
+}
+
+bool rn_clause_less(int a, int b)
+{
+	return rn_clause_key[a] < rn_clause_key[b] || (rn_clause_key[a]==rn_clause_key[b] && a<b);
+}
+
+/* mean distance between the smallest and largest variable index of a clause */
+double rn_mean_clause_span()
+{
+	int c, i, lo, hi;
+	double sum = 0.0;
+	for (c=0; c<num_clauses; ++c)
+	{
+		lo = num_vars+1;
+		hi = 0;
+		for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; ++i)
+		{
+			lo = min(lo, lit_var(clause_lit[i]));
+			hi = max(hi, lit_var(clause_lit[i]));
+		}
+		if (hi>=lo) sum += hi-lo;
+	}
+	return num_clauses ? sum/num_clauses : 0.0;
+}
+
+
+/* Renumbers variables and clauses of the loaded formula for locality */
+void renumber()
+{
+	int v, u, c, i, j, k, head, start, next;
+	double span_before = rn_mean_clause_span();
+	vector<int> order, new_index(num_vars+1, 0), by_degree, clause_order;
+	vector<int> old_weight, old_count;
+	vector<char> visited(num_vars+1, 0);
+	vector<int> neighbors;
+
+	// vertices are visited from the lowest-degree unvisited vertex of each component, and
+	// the neighbors of each vertex are queued in increasing order of degree. The number of
+	// occurrences of a variable stands in for its degree, which would cost a neighbor build.
+	for (v=1; v<=num_vars; ++v) by_degree.push_back(v);
+	sort(by_degree.begin(), by_degree.end(), rn_var_less);
+
+	for (start=0; start<(int)by_degree.size(); ++start)
+	{
+		if (visited[by_degree[start]]) continue;
+		head = order.size();
+		order.push_back(by_degree[start]);
+		visited[by_degree[start]] = 1;
+		while (head<(int)order.size())
+		{
+			v = order[head++];
+			neighbors.clear();
+			for (i=var_lit_start[v]; i<var_lit_start[v+1]; ++i)
+			{
+				c = occ_clause(var_lit[i]);
+				for (j=clause_lit_start[c]; j<clause_lit_start[c+1]; ++j)
+				{
+					u = lit_var(clause_lit[j]);
+					if (visited[u]) continue;
+					visited[u] = 1;
+					neighbors.push_back(u);
+				}
+			}
+			sort(neighbors.begin(), neighbors.end(), rn_var_less);
+			order.insert(order.end(), neighbors.begin(), neighbors.end());
+		}
+	}
+
+	// reversing the Cuthill-McKee order reduces the profile further
+	rn_var_orig = new int[num_vars+1];
+	for (k=0; k<num_vars; ++k)
+	{
+		next = num_vars-k;
+		new_index[order[k]] = next;
+		rn_var_orig[next] = order[k];
+	}
+
+	// sort the clauses by their smallest new variable index
+	rn_clause_key.resize(num_clauses);
+	for (c=0; c<num_clauses; ++c)
+	{
+		rn_clause_key[c] = num_vars+1;
+		for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; ++i)
+			rn_clause_key[c] = min(rn_clause_key[c], new_index[lit_var(clause_lit[i])]);
+		clause_order.push_back(c);
+	}
+	sort(clause_order.begin(), clause_order.end(), rn_clause_less);
+	vector<int>().swap(rn_clause_key);
+
+	// and rebuild the instance in the new order
+	old_weight.assign(clause_weight, clause_weight+num_clauses);
+	old_count.assign(clause_lit_count, clause_lit_count+num_clauses);
+	for (k=0; k<num_clauses; ++k)
+	{
+		c = clause_order[k];
+		start = lit_buffer.size();
+		for (i=clause_lit_start[c]; i<clause_lit_start[c+1]; ++i)
+			lit_buffer.push_back(make_lit(new_index[lit_var(clause_lit[i])], lit_sense(clause_lit[i])));
+		sort(lit_buffer.begin()+start, lit_buffer.end());
+		clause_weight[k] = old_weight[c];
+		clause_lit_count[k] = old_count[c];
+	}
+	delete[] clause_lit;
+	delete[] clause_lit_start;
+	delete[] var_lit;
+	delete[] var_lit_start;
+	build_literal_arrays();
+	rn_enabled = 1;
+
+	printf("c renumbering: mean clause span %.1f -> %.1f\n", span_before, rn_mean_clause_span());
+	fflush(stdout);
+}
+
+
+/* Maps the assignment <soln> of the renumbered formula back to the numbering before
+ * renumber() */
+void rn_restore(int* soln, int* old_soln)
+{
+	int v;
+	for (v=1; v<=num_vars; ++v)
+		old_soln[rn_var_orig[v]] = soln[v];
+}
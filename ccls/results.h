@@ -0,0 +1,128 @@
+/* Machine-readable results of the CCLS driver
+ *
+ * With -o FILE, performRuns() writes one record per run to FILE as soon as the run ends, so a
+ * sweep holds no more than one record in memory. FILE gets JSON lines, one object per line,
+ * unless its name ends in .csv, in which case it gets a header line and one row per run. A
+ * record is built in <rs_record> and handed to stdio, whose RS_BUFFER bytes of buffer reach
+ * the file in blocks. Every record has the same fields in the same order; a missing value is
+ * null in JSON and an empty cell in CSV.
+ */
+
+#define RS_BUFFER (1<<20)
+
+FILE*	rs_file = NULL;		//NULL without -o
+int		rs_csv = 0;
+int		rs_records = 0;		//number of records written so far
+int		rs_fields;			//number of fields in the current record
+string	rs_record;			//the current record
+string	rs_header;			//CSV header, taken from the field names of the first record
+
+
+/* opens <path> for the results, JSON lines or CSV by its extension; returns 0 on failure */
+int rs_open(const char* path)
+{
+	size_t len = strlen(path);
+	rs_csv = (len>=4 && strcmp(path+len-4, ".csv")==0);
+	rs_file = fopen(path, "w");
+	if (!rs_file) return 0;
+	setvbuf(rs_file, NULL, _IOFBF, RS_BUFFER);
+	return 1;
+}
+
+void rs_close()
+{
+	if (rs_file) fclose(rs_file);
+	rs_file = NULL;
+}
+
+void rs_begin()
+{
+	rs_record.clear();
+	rs_header.clear();
+	rs_fields = 0;
+}
+
+/* starts field <name> of the current record */
+void rs_key(const char* name)
+{
+	if (rs_fields++) {
+		rs_record += ',';
+		rs_header += ',';
+	}
+	if (rs_csv) {
+		rs_header += name;
+	}
+	else {
+		rs_record += '"';
+		rs_record += name;
+		rs_record += "\":";
+	}
+}
+
+void rs_int(const char* name, long long value)
+{
+	char buf[32];
+	rs_key(name);
+	sprintf(buf, "%lld", value);
+	rs_record += buf;
+}
+
+void rs_double(const char* name, double value)
+{
+	char buf[32];
+	rs_key(name);
+	sprintf(buf, "%.9g", value);
+	rs_record += buf;
+}
+
+void rs_null(const char* name)
+{
+	rs_key(name);
+	if (!rs_csv) rs_record += "null";
+}
+
+void rs_string(const char* name, const char* value)
+{
+	rs_key(name);
+	rs_record += '"';
+	for (; *value; ++value)
+	{
+		if (*value=='"') rs_record += rs_csv ? "\"" : "\\";
+		else if (*value=='\\' && !rs_csv) rs_record += '\\';
+		rs_record += *value;
+	}
+	rs_record += '"';
+}
+
+/* assignment <soln> of variables 1..n: an array of 0/1 in JSON, a string of 0/1 in CSV */
+void rs_model(const char* name, const int* soln, int n)
+{
+	int i;
+	rs_key(name);
+	rs_record += rs_csv ? '"' : '[';
+	for (i=1; i<=n; ++i)
+	{
+		if (i>1 && !rs_csv) rs_record += ',';
+		rs_record += soln[i] ? '1' : '0';
+	}
+	rs_record += rs_csv ? '"' : ']';
+}
+
+/* writes the current record */
+void rs_end()
+{
+	if (rs_csv) {
+		if (rs_records==0) {
+			fputs(rs_header.c_str(), rs_file);
+			fputc('\n', rs_file);
+		}
+		fputs(rs_record.c_str(), rs_file);
+	}
+	else {
+		fputc('{', rs_file);
+		fputs(rs_record.c_str(), rs_file);
+		fputc('}', rs_file);
+	}
+	fputc('\n', rs_file);
+	rs_records++;
+}
@@ -0,0 +1,82 @@
+/* Work-stealing scheduler for UCT subtree tasks
+ *
+ * A task is the UCT tree of one cube of the search space (see cooperate.h for cubes). Each
+ * thread owns a ws_deque of tasks: it takes the task at the back, runs a slice of UCT
+ * iterations on it and puts it back unless its tree has closed. A thread whose deque is
+ * empty steals the task at the front of another thread's deque, so the threads stay busy
+ * when the subtrees of some cubes close early. Every task of a run gets its own id, the
+ * cubes' tasks first and then the tasks over the whole search space that threads start once
+ * no task is left, so the trace tells their trees apart.
+ */
+
+#include <deque>
+
+#define WS_SLICE 16		//UCT iterations per turn of a task
+
+atomic<unsigned int> ws_task_ids(0);	//ids handed out in the current run
+
+struct ws_task
+{
+	uctnode*		root;		//NULL until the task runs for the first time
+	int				cube;
+	int				depth;		//number of fixed atoms, 0 for a task over the whole search space
+	unsigned int	id;
+
+	ws_task(int c, int d) : root(NULL), cube(c), depth(d), id(ws_task_ids++) {}
+	~ws_task() { if (root) freeNode(root); }
+};
+
+class ws_deque
+{
+public:
+	mutex				lock;
+	deque<ws_task*>		tasks;
+
+	void put(ws_task* task) {
+		lock_guard<mutex> guard(lock);
+		tasks.push_back(task);
+	}
+
+	/* the owner's end */
+	ws_task* take() {
+		lock_guard<mutex> guard(lock);
+		if (tasks.empty()) return NULL;
+		ws_task* task = tasks.back();
+		tasks.pop_back();
+		return task;
+	}
+
+	/* the thieves' end */
+	ws_task* steal() {
+		lock_guard<mutex> guard(lock);
+		if (tasks.empty()) return NULL;
+		ws_task* task = tasks.front();
+		tasks.pop_front();
+		return task;
+	}
+
+	void clear() {
+		lock_guard<mutex> guard(lock);
+		while (!tasks.empty()) {
+			delete tasks.back();
+			tasks.pop_back();
+		}
+	}
+};
+
+vector<ws_deque*> ws_deques;	//one per thread
+
+
+/* steals a task for thread <self>, trying the other threads from a random one on */
+ws_task* ws_steal(int self, int start)
+{
+	int			i, n = ws_deques.size();
+	ws_task*	task;
+	for (i=0; i<n; ++i)
+	{
+		if ((start+i)%n == self) continue;
+		task = ws_deques[(start+i)%n]->steal();
+		if (task) return task;
+	}
+	return NULL;
+}
@@ -0,0 +1,136 @@
+/* Binary trace of the UCT iterations of the CCLS driver
+ *
+ * With -z FILE, every engine logs each of its UCT iterations: the (atom, arm) choices from the
+ * root down to the new leaf, the atom of the leaf, the rewards and closing of its two arms,
+ * and the flips and lowest cost of the iteration's SLS runs. An engine puts its records into a tr_ring of its
+ * own without taking a lock, and a background thread drains the rings into FILE, so the
+ * engines only wait when a ring is full. FILE starts with a tr_header, followed by the records
+ * of all engines, each a tr_record and its <depth> path entries atom<<1|arm. The records of
+ * different engines interleave, but a record is never split. The format is that of the
+ * machine that writes it. trace_replay.cpp rebuilds the UCT trees from a trace.
+ */
+
+#include <stdint.h>
+
+#define TR_VERSION 3
+#define TR_RING (1<<22)		//minimum size of an engine's ring, in bytes
+#define TR_BUFFER (1<<20)	//stdio buffer of the trace file
+#define TR_NO_COST (~0ULL)	//cost of an iteration whose arms closed without SLS
+
+struct tr_header
+{
+	char		magic[8];		//"UCTTRACE"
+	uint32_t	version;
+	uint32_t	num_vars;
+	uint32_t	depth_limit;	//both arms of a leaf at this depth close
+	uint32_t	stealing;		//whether the trees are the tasks of -k rather than one per engine
+	double		c;				//UCT exploration parameter of engine 0
+	uint64_t	cost_offset;	//weight the preprocessing moved out of the searched formula
+};
+
+struct tr_record
+{
+	double		reward[2];		//rewards of the leaf's arms
+	uint64_t	cost;			//lowest cost of the searched formula the SLS runs reached
+	uint32_t	run;
+	uint32_t	engine;
+	uint32_t	cube;			//the tree's cube with -k, 0 otherwise
+	uint32_t	task;			//the tree's work-stealing task with -k, 0 otherwise
+	uint32_t	iteration;		//UCT iteration of the engine in the run, from 1
+	uint32_t	flips;			//flips of the iteration's SLS runs
+	uint32_t	leaf;			//atom of the leaf
+	uint32_t	closed;			//bit a is set if arm a of the leaf is closed
+	uint32_t	depth;			//number of path entries that follow
+};
+
+/* Byte ring with one producer, the engine, and one consumer, the flush thread */
+class tr_ring
+{
+public:
+	char*			buf;
+	size_t			size;		//a power of two
+	atomic<size_t>	head;		//bytes put so far
+	atomic<size_t>	tail;		//bytes drained so far
+
+	tr_ring(size_t bytes) : head(0), tail(0) {
+		for (size = TR_RING; size < bytes; size *= 2);
+		buf = new char[size];
+	}
+	~tr_ring() { delete[] buf; }
+
+	/* appends <len> bytes, waiting for the flush thread while the ring is too full */
+	void put(const char* data, size_t len) {
+		size_t h = head.load(memory_order_relaxed);
+		size_t at = h & (size-1);
+		size_t first = min(len, size-at);
+		while (size - (h - tail.load(memory_order_acquire)) < len) this_thread::yield();
+		memcpy(buf+at, data, first);
+		memcpy(buf, data+first, len-first);
+		head.store(h+len, memory_order_release);
+	}
+
+	/* writes everything put so far to <file>, returns the number of bytes */
+	size_t drain(FILE* file) {
+		size_t t = tail.load(memory_order_relaxed);
+		size_t h = head.load(memory_order_acquire);
+		size_t at = t & (size-1);
+		size_t first = min(h-t, size-at);
+		fwrite(buf+at, 1, first, file);
+		fwrite(buf, 1, h-t-first, file);
+		tail.store(h, memory_order_release);
+		return h-t;
+	}
+};
+
+FILE*				tr_file = NULL;		//NULL without -z
+vector<tr_ring*>	tr_rings;			//one per engine
+thread				tr_flusher;
+atomic<int>			tr_stop(0);
+uint32_t			tr_run;				//the current run
+
+
+void tr_flush_loop()
+{
+	size_t	n;
+	int		stopping;
+	for (;;)
+	{
+		// the engines have put all their records before <tr_stop> is set
+		stopping = tr_stop.load(memory_order_acquire);
+		n = 0;
+		for (size_t k=0; k<tr_rings.size(); ++k) n += tr_rings[k]->drain(tr_file);
+		if (stopping) break;
+		if (n==0) this_thread::sleep_for(chrono::milliseconds(1));
+	}
+}
+
+/* writes the header and starts the flush thread, with one ring for each of <engines>
+ * engines; a ring holds at least two records of the deepest possible path */
+void tr_start(int engines, int stealing, double c, unsigned long long cost_offset)
+{
+	tr_header header;
+	int k;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "UCTTRACE", 8);
+	header.version = TR_VERSION;
+	header.num_vars = num_vars;
+	header.depth_limit = depthLimit;
+	header.stealing = stealing;
+	header.c = c;
+	header.cost_offset = cost_offset;
+	fwrite(&header, sizeof(header), 1, tr_file);
+	for (k=0; k<engines; ++k)
+		tr_rings.push_back(new tr_ring(2*(sizeof(tr_record) + (num_vars+1)*sizeof(uint32_t))));
+	tr_flusher = thread(tr_flush_loop);
+}
+
+/* drains the rings a last time and closes the trace */
+void tr_finish()
+{
+	tr_stop.store(1, memory_order_release);
+	tr_flusher.join();
+	for (size_t k=0; k<tr_rings.size(); ++k) delete tr_rings[k];
+	tr_rings.clear();
+	fclose(tr_file);
+	tr_file = NULL;
+}
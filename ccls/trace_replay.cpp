@@ -0,0 +1,229 @@
+/* Offline replay of a UCT iteration trace written by uct -z
+ *
+ * Rebuilds the UCT tree of every run and engine (or task, with -k) from the paths, leaf
+ * rewards and closed arms of the trace, with the same visit counts, mean rewards and closing
+ * as playNode, without running any SLS, and prints the statistics of each tree. With -c, it
+ * also replays every choice between two open arms with UCB1 under the given exploration
+ * parameter and reports how often it agrees with the arm the run played.
+ *
+ * g++ -O2 trace_replay.cpp -o replay
+ * ./replay TRACE [-c DOUBLE]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+using namespace std;
+
+int num_vars, depthLimit; // used by trace.h
+#include "trace.h"
+
+#define LEFT 0
+#define RIGHT 1
+#define BF 2
+
+/* A node of a rebuilt tree */
+struct replayNode {
+  double x[BF];
+  int n[BF];
+  unsigned int atom;
+  int closed[BF];
+  int depth;
+  replayNode *children[BF];
+};
+
+/* A rebuilt tree and its statistics */
+struct replayTree {
+  replayNode *root;
+  unsigned int cube;
+  unsigned long long iterations;
+  unsigned long long flips;
+  unsigned long long nodes; // counted like the engines count them, BF per expansion
+  unsigned long long leafDepth; // sum of the depths of the leaves
+  int maxDepth;
+  unsigned long long bestCost; // lowest SLS cost of the searched formula, TR_NO_COST if none
+  unsigned long long mismatches; // path atoms that differ from the rebuilt node's atom
+};
+
+tr_header header;
+double replayC = -1; // exploration parameter of the UCB1 replay, -1 for none
+unsigned long long choices = 0, agreements = 0;
+
+
+replayNode *newNode(unsigned int atom, int depth) {
+  replayNode *node = new replayNode;
+  memset(node, 0, sizeof(*node));
+  node->atom = atom;
+  node->depth = depth;
+  return node;
+}
+
+void freeNode(replayNode *node) {
+  if (!node) return;
+  freeNode(node->children[LEFT]);
+  freeNode(node->children[RIGHT]);
+  delete node;
+}
+
+/* the arm UCB1 with <replayC> plays at <node>, as selectMove computes it; -1 for a tie */
+int ucbMove(replayNode *node) {
+  float scoreL, scoreR;
+  scoreL = node->x[LEFT] + replayC*sqrt(log(node->n[LEFT]+node->n[RIGHT])/ (float) node->n[LEFT]);
+  scoreR = node->x[RIGHT] + replayC*sqrt(log(node->n[LEFT]+node->n[RIGHT])/ (float) node->n[RIGHT]);
+  if (scoreL==scoreR) return -1;
+  return scoreR>scoreL;
+}
+
+/* Plays the iteration of <record>, with path entries <path>, on <tree> */
+void replay(replayTree &tree, const tr_record &record, const vector<uint32_t> &path) {
+  vector<replayNode*> nodes;
+  replayNode *node;
+  unsigned int atom;
+  double reward;
+  int i, arm, move;
+
+  if (!tree.root) {
+    tree.root = newNode(path.empty() ? record.leaf : path[0]>>1, 0);
+    tree.cube = record.cube;
+    tree.nodes = 1;
+    tree.bestCost = TR_NO_COST;
+  }
+  node = tree.root;
+
+  // walk down the path, counting the visits
+  for (i=0; i<(int)path.size(); i++) {
+    atom = path[i]>>1;
+    arm = path[i]&1;
+    tree.mismatches += (node->atom != atom);
+    if (replayC>=0 && !node->closed[LEFT] && !node->closed[RIGHT]) {
+      move = ucbMove(node);
+      choices++;
+      agreements += (move==arm || move<0);
+    }
+    node->n[arm]++;
+    nodes.push_back(node);
+    if (!node->children[LEFT]) {
+      node->children[LEFT] = newNode(0, node->depth+1);
+      node->children[RIGHT] = newNode(0, node->depth+1);
+      tree.nodes += BF;
+    }
+    node = node->children[arm];
+    if (!node->atom) node->atom = (i+1<(int)path.size()) ? path[i+1]>>1 : record.leaf;
+  }
+
+  // the leaf plays both arms
+  tree.mismatches += (node->atom != record.leaf);
+  node->n[LEFT] = node->n[RIGHT] = 1;
+  node->x[LEFT] = record.reward[LEFT];
+  node->x[RIGHT] = record.reward[RIGHT];
+  node->closed[LEFT] = record.closed & 1;
+  node->closed[RIGHT] = (record.closed>>1) & 1;
+  reward = (node->x[LEFT]+node->x[RIGHT])/2.0;
+
+  tree.iterations++;
+  tree.flips += record.flips;
+  tree.leafDepth += node->depth;
+  tree.maxDepth = max(tree.maxDepth, node->depth);
+  tree.bestCost = min(tree.bestCost, (unsigned long long)record.cost);
+
+  // back the reward and the closed arms up to the root
+  for (i=(int)nodes.size()-1; i>=0; i--) {
+    node = nodes[i];
+    arm = path[i]&1;
+    node->x[arm] += (reward-node->x[arm])/node->n[arm];
+    if (node->children[arm]->closed[LEFT] && node->children[arm]->closed[RIGHT]) {
+      node->closed[arm] = 1;
+    }
+  }
+}
+
+void printUsageError() {
+  printf("Usage: replay TRACE [-c DOUBLE]\n");
+  printf("-c : replay the choices between two open arms with UCB1 and this exploration parameter (off)\n");
+  exit(1);
+}
+
+int main(int argc, char *argv[]) {
+  FILE *file;
+  tr_record record;
+  vector<uint32_t> path;
+  map< pair<unsigned int, unsigned int>, replayTree > trees; // by run, and engine or task
+  map< pair<unsigned int, unsigned int>, replayTree >::iterator t;
+  unsigned long long records = 0;
+  int option;
+
+  while ((option = getopt(argc, argv, "c:")) != -1) {
+    switch (option) {
+      case 'c':
+        replayC = atof(optarg);
+        break;
+      default:
+        printUsageError();
+    }
+  }
+  if (optind != argc-1) printUsageError();
+
+  file = fopen(argv[optind], "rb");
+  if (!file) {
+    printf("Cannot open trace file: %s\n", argv[optind]);
+    return 1;
+  }
+  if (fread(&header, sizeof(header), 1, file)!=1 || memcmp(header.magic, "UCTTRACE", 8)!=0) {
+    printf("%s is not a UCT trace\n", argv[optind]);
+    return 1;
+  }
+  if (header.version!=TR_VERSION) {
+    printf("Trace version %u is not supported\n", header.version);
+    return 1;
+  }
+
+  while (fread(&record, sizeof(record), 1, file)==1) {
+    path.resize(record.depth);
+    if (record.depth && fread(path.data(), sizeof(uint32_t), record.depth, file)!=record.depth) {
+      printf("Truncated record at the end of the trace\n");
+      break;
+    }
+    replayTree &tree = trees[make_pair(record.run, header.stealing ? record.task : record.engine)];
+    replay(tree, record, path);
+    records++;
+  }
+  fclose(file);
+
+  printf("Trace: %s\n", argv[optind]);
+  printf("Records: %llu, vars %u, depth limit %u, C %f, %s\n", records, header.num_vars,
+         header.depth_limit, header.c, header.stealing ? "trees per task" : "trees per engine");
+  for (t=trees.begin(); t!=trees.end(); ++t) {
+    replayTree &tree = t->second;
+    if (header.stealing) {
+      printf("Run %u task %u cube %u: ", t->first.first, t->first.second, tree.cube);
+    }
+    else {
+      printf("Run %u engine %u: ", t->first.first, t->first.second);
+    }
+    printf("%llu iterations, %llu flips, %llu nodes, leaf depth %.2f max %d, ", tree.iterations, tree.flips,
+           tree.nodes, tree.leafDepth/(double)tree.iterations, tree.maxDepth);
+    if (tree.bestCost==TR_NO_COST) {
+      printf("best cost none, ");
+    }
+    else {
+      printf("best cost %llu, ", tree.bestCost + (unsigned long long)header.cost_offset);
+    }
+    printf("root visits %d/%d rewards %.6f/%.6f closed %d/%d", tree.root->n[LEFT], tree.root->n[RIGHT],
+           tree.root->x[LEFT], tree.root->x[RIGHT], tree.root->closed[LEFT], tree.root->closed[RIGHT]);
+    if (tree.mismatches) printf(", %llu inconsistent atoms", tree.mismatches);
+    printf("\n");
+    freeNode(tree.root);
+  }
+  if (replayC>=0) {
+    printf("UCB1 with C %f agrees with %llu of %llu choices between two open arms (%.2f%%)\n",
+           replayC, agreements, choices, choices ? 100.0*agreements/choices : 0.0);
+  }
+  return 0;
+}
@@ -22,15 +22,15 @@
 
 #include "ubcsat.h"
 
-UINT32 iInvPhi=5;               /* = 1/phi   */
-UINT32 iInvTheta=6;             /* = 1/theta */
+THREADLOCAL UINT32 iInvPhi=5;               /* = 1/phi   */
+THREADLOCAL UINT32 iInvTheta=6;             /* = 1/theta */
 
-FLOAT fAdaptPhi;
-FLOAT fAdaptTheta;
+THREADLOCAL FLOAT fAdaptPhi;
+THREADLOCAL FLOAT fAdaptTheta;
 
-UINT32 iLastAdaptStep;
-UINT32 iLastAdaptNumFalse;
-FLOAT fLastAdaptSumFalseW;
+THREADLOCAL UINT32 iLastAdaptStep;
+THREADLOCAL UINT32 iLastAdaptNumFalse;
+THREADLOCAL FLOAT fLastAdaptSumFalseW;
 
 void InitAdaptNoveltyNoise();
 void AdaptNoveltyNoise();
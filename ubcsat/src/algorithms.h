@@ -29,12 +29,12 @@ void AddGSat();
 /* gwsat.c */
 
 void AddGWSat();
-extern PROBABILITY iWp;
+extern THREADLOCAL PROBABILITY iWp;
 
 /* gsat-tabu.c */
 
 void AddGSatTabu();
-extern UINT32 iTabuTenure;
+extern THREADLOCAL UINT32 iTabuTenure;
 
 /* hsat.c */
 
@@ -55,7 +55,7 @@ UINT32 PickClauseWCS();
 
 void AddWalkSatTabu();
 void PickWalkSatTabu();
-extern UINT32 iWalkSATTabuClause;
+extern THREADLOCAL UINT32 iWalkSATTabuClause;
 
 /* novelty.c */
 
@@ -70,8 +70,8 @@ void PickNoveltyVarScore();
 void PickNoveltyPlusVarScore();
 void PickNoveltyPlusPlusVarScore();
 
-extern PROBABILITY iNovNoise;
-extern PROBABILITY iDp;
+extern THREADLOCAL PROBABILITY iNovNoise;
+extern THREADLOCAL PROBABILITY iDp;
 
 /* novelty+p.c */
 
@@ -88,13 +88,13 @@ void AddRNoveltyPlus();
 void AddAdaptNoveltyPlus();
 void InitAdaptNoveltyNoise();
 void AdaptNoveltyNoiseAdjust();
-extern UINT32 iLastAdaptStep;
-extern UINT32 iLastAdaptNumFalse;
-extern FLOAT fLastAdaptSumFalseW;
-extern UINT32 iInvPhi;
-extern UINT32 iInvTheta;
-extern FLOAT fAdaptPhi;
-extern FLOAT fAdaptTheta;
+extern THREADLOCAL UINT32 iLastAdaptStep;
+extern THREADLOCAL UINT32 iLastAdaptNumFalse;
+extern THREADLOCAL FLOAT fLastAdaptSumFalseW;
+extern THREADLOCAL UINT32 iInvPhi;
+extern THREADLOCAL UINT32 iInvTheta;
+extern THREADLOCAL FLOAT fAdaptPhi;
+extern THREADLOCAL FLOAT fAdaptTheta;
 
 /* saps.c */
 
@@ -103,7 +103,7 @@ void AddSAPS();
 /* paws.c */
 
 void AddPAWS();
-extern PROBABILITY iPAWSFlatMove;
+extern THREADLOCAL PROBABILITY iPAWSFlatMove;
 
 /* ddfw.c */
 
@@ -122,9 +122,9 @@ void AddVW();
 void AddRoTS();
 void PickRoTS();
 
-extern UINT32 iTabuTenureInterval;
-extern UINT32 iTabuTenureLow;
-extern UINT32 iTabuTenureHigh;
+extern THREADLOCAL UINT32 iTabuTenureInterval;
+extern THREADLOCAL UINT32 iTabuTenureLow;
+extern THREADLOCAL UINT32 iTabuTenureHigh;
 
 /* irots.c */
 
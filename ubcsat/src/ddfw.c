@@ -25,8 +25,8 @@
 void SetupDDFW();
 void DistributeDDFW();
 
-UINT32 iDDFWInitWeight;
-PROBABILITY iDDFW_TL;
+THREADLOCAL UINT32 iDDFWInitWeight;
+THREADLOCAL PROBABILITY iDDFW_TL;
 
 void AddDDFW() {
 
@@ -30,17 +30,17 @@ void CreateNextClauseLit();
 void InitNextClauseLit();
 void UpdateNextClauseLit();
 
-UINT32 iClausePick;
-UINT32 *aClausePickCount;  
-UINT32 *aNextClauseLit;
+THREADLOCAL UINT32 iClausePick;
+THREADLOCAL UINT32 *aClausePickCount;  
+THREADLOCAL UINT32 *aNextClauseLit;
 
 
 void PickDANOVP();
 void InitAdaptNoveltyNoiseDet();
 void AdaptNoveltyNoiseDet();
 
-UINT32 iCountNovNoise0;
-UINT32 iCountNovNoise1;
+THREADLOCAL UINT32 iCountNovNoise0;
+THREADLOCAL UINT32 iCountNovNoise1;
 
 
 void AddDerandomized() {
@@ -22,7 +22,7 @@
 
 #include "ubcsat.h"
 
-UINT32 iTabuTenure;
+THREADLOCAL UINT32 iTabuTenure;
 
 void PickGSatTabu();
 void PickGSatTabuW();
@@ -22,7 +22,7 @@
 
 #include "ubcsat.h"
 
-PROBABILITY iWp;
+THREADLOCAL PROBABILITY iWp;
 
 void PickGWSat();
 void PickGWSatW();
@@ -27,29 +27,29 @@
    ways.  in this implementation we have strived to match the
    text of the AI 2003 paper exactly */
 
-UINT32 iIrotsEscapeSteps;
-UINT32 iIrotsPerturbSteps;
+THREADLOCAL UINT32 iIrotsEscapeSteps;
+THREADLOCAL UINT32 iIrotsPerturbSteps;
 
-UINT32 iLSTabuTenure;
-UINT32 iPerturbTabuTenure;
+THREADLOCAL UINT32 iLSTabuTenure;
+THREADLOCAL UINT32 iPerturbTabuTenure;
 
-PROBABILITY iIrotsNoise;
+THREADLOCAL PROBABILITY iIrotsNoise;
 
-UINT32 iLSTabuTenureLow;
-UINT32 iLSTabuTenureHigh;
-UINT32 iPerturbTabuTenureLow;
-UINT32 iPerturbTabuTenureHigh;
+THREADLOCAL UINT32 iLSTabuTenureLow;
+THREADLOCAL UINT32 iLSTabuTenureHigh;
+THREADLOCAL UINT32 iPerturbTabuTenureLow;
+THREADLOCAL UINT32 iPerturbTabuTenureHigh;
 
-UINT32 iIrotsLSBestStep;
-UINT32 iIrotsLSBestValue;
-FLOAT fIrotsLSBestValueW;
+THREADLOCAL UINT32 iIrotsLSBestStep;
+THREADLOCAL UINT32 iIrotsLSBestValue;
+THREADLOCAL FLOAT fIrotsLSBestValueW;
 
-UINT32 iIrotsSavedValue;
-FLOAT fIrotsSavedValueW;
+THREADLOCAL UINT32 iIrotsSavedValue;
+THREADLOCAL FLOAT fIrotsSavedValueW;
 
-UINT32 iIrotsMode;
+THREADLOCAL UINT32 iIrotsMode;
 
-UINT32 *aIrotsBackup;
+THREADLOCAL UINT32 *aIrotsBackup;
 
 void InitIRoTSParms();
 void InitIRoTS();
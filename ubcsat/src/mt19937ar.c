@@ -43,6 +43,10 @@
 
 #include <stdio.h>
 
+#ifndef THREADLOCAL
+#define THREADLOCAL __thread
+#endif
+
 /* Period parameters */  
 #define N 624
 #define M 397
@@ -50,8 +54,8 @@
 #define UPPER_MASK 0x80000000UL /* most significant w-r bits */
 #define LOWER_MASK 0x7fffffffUL /* least significant r bits */
 
-static unsigned long mt[N]; /* the array for the state vector  */
-static int mti=N+1; /* mti==N+1 means mt[N] is not initialized */
+static THREADLOCAL unsigned long mt[N]; /* the array for the state vector  */
+static THREADLOCAL int mti=N+1; /* mti==N+1 means mt[N] is not initialized */
 
 /* initializes mt[N] with a seed */
 void init_genrand(unsigned long s)
@@ -22,6 +22,16 @@
 
 #include "ubcsat.h"
 
+/* UCT state, declared in ubcsat.h */
+
+THREADLOCAL BITWORD varMutable[BitsetWords(MAX_NUM_VARS+1)];
+THREADLOCAL BITWORD preSat[BitsetWords(MAX_NUM_CLAUSES)];
+BITWORD alwaysSat[BitsetWords(MAX_NUM_CLAUSES)];
+THREADLOCAL short bPresatTerminate;
+THREADLOCAL BOOL closedFlag;
+
+THREADLOCAL int bestSoln[MAX_NUM_VARS+1];
+
 /*  
 
   AddLocal() is here for you to add your own algorithms, reports, etc... 
@@ -38,6 +48,8 @@ void PickWalkSatTabuNoNull();
 
 void AddWalkSatUCT();
 void PickWalkSatUCT();
+void PickWalkSatUCTW();
+UINT32 PickClauseUCTW();
 
 void AddRNoveltyUCT();
 void PickRNoveltyUCT();
@@ -45,6 +57,7 @@ void PickRNoveltyCoreUCT();
 
 void AddNoveltyUCT();
 void PickNoveltyUCT();
+void PickNoveltyUCTW();
 
 void AddAgeStat();
 void UpdateCurVarAge();
@@ -71,7 +84,7 @@ void AddWalkSatUCT() {
     "WALKSAT-UCT: Walksat with a set of immutable variables",
     "Selman, Kautz, Cohen [AAAI 94] (modified)",
     "PickWalkSatUCT",
-    "DefaultProceduresUCT,Flip+FalseClauseList,BestFalse",
+    "DefaultProceduresUCT,Flip+MakeBreakUCT,BestFalse",
     "default",
     "default");
   
@@ -84,21 +97,36 @@ void AddWalkSatUCT() {
     "",
     "");
 
+
+  pCurAlg = CreateAlgorithm(
+    "walksat","uct",TRUE,
+    "WALKSAT-UCT: Walksat with a set of immutable variables (weighted)",
+    "Selman, Kautz, Cohen [AAAI 94] (modified)",
+    "PickWalkSatUCTW",
+    "DefaultProceduresUCTW,Flip+MakeBreakUCTW,BestFalse",
+    "default_w",
+    "default");
+  
+  CopyParameters(pCurAlg,"walksat","",FALSE);
+
+  CreateTrigger("PickWalkSatUCTW",
+    ChooseCandidate,
+    PickWalkSatUCTW,
+    "",
+    "");
+
 }
 
 void PickWalkSatUCT() {
  
-  UINT32 i;
   UINT32 j;
   SINT32 iScore;
   UINT32 iClause;
   UINT32 iClauseLen;
   UINT32 iVar;
   LITTYPE *pLit;
-  UINT32 *pClause;
   LITTYPE litPick;
-  UINT32 iNumOcc;
-  UINT32 falseClauses[iNumClauses]; //doesn't include preSat clauses
+  UINT32 falseClauses[iNumFalse+1]; //doesn't include preSat clauses
   int numFalseClauses = 0;
 
   iNumCandidates = 0;
@@ -107,10 +135,10 @@ void PickWalkSatUCT() {
   // If there are unsat clauses ...
   if (iNumFalse) {
   
-    // construct <falseClauses>
-    for (j=0; j<iNumClauses; j++) {
-      if (!preSat[j] && aNumTrueLit[j]==0) {
-        falseClauses[numFalseClauses++] = j;
+    // construct <falseClauses> from the false clause list kept by Flip+MakeBreakUCT
+    for (j=0; j<iNumFalse; j++) {
+      if (!IsPreSat(aFalseList[j])) {
+        falseClauses[numFalseClauses++] = aFalseList[j];
       }
     }
     
@@ -141,28 +169,17 @@ void PickWalkSatUCT() {
   pLit = pClauseLits[iClause];
 
   for (j=0;j<iClauseLen;j++) {
-    // for WalkSAT variants, it's faster to calculate the score for each literal than to
-	// cache the values. Note that in this case, score is just the breakcount[]
+    // the score is just the breakcount[], kept up to date by Flip+MakeBreakUCT
  
     iVar = GetVarFromLit(*pLit);
     
     // Don't consider variables that are immutable
-    if (!varMutable[iVar]) {
+    if (!IsMutable(iVar)) {
       pLit++;
       continue;
     }
     
-    iScore = 0;
-    
-    iNumOcc = aNumLitOcc[GetNegatedLit(*pLit)];
-    pClause = pLitClause[GetNegatedLit(*pLit)];
-    
-    for (i=0;i<iNumOcc;i++) {
-      if (aNumTrueLit[*pClause]==1) {
-        iScore++;
-      }
-      pClause++;
-    }
+    iScore = aBreakCount[iVar];
 
     // build candidate list of best vars
     if (iScore <= iBestScore) {
@@ -182,7 +199,7 @@ void PickWalkSatUCT() {
     if (RandomProb(iWp)) {
       litPick = pClauseLits[iClause][RandomInt(iClauseLen)];
       iFlipCandidate = GetVarFromLit(litPick);
-      if (!varMutable[iFlipCandidate]) {
+      if (!IsMutable(iFlipCandidate)) {
         iFlipCandidate=0;
       }
       return;
@@ -199,6 +216,108 @@ void PickWalkSatUCT() {
 
 
 
+UINT32 PickClauseUCTW() {
+
+  // roulette selection of a false clause that isn't preSat, so that clauses with larger
+  // weights (the hard clauses of a partial instance) are more likely to be selected.
+  // Returns iNumClauses if every false clause is preSat
+
+  UINT32 j;
+  UINT32 iClause = iNumClauses;
+  FLOAT fRandClause;
+  FLOAT fClauseSum = FLOATZERO;
+
+  for (j=0;j<iNumFalse;j++) {
+    if (!IsPreSat(aFalseList[j])) {
+      fClauseSum += aClauseWeight[aFalseList[j]];
+    }
+  }
+
+  fRandClause = RandomFloat() * fClauseSum;
+  fClauseSum = FLOATZERO;
+
+  for (j=0;j<iNumFalse;j++) {
+    if (IsPreSat(aFalseList[j])) {
+      continue;
+    }
+    iClause = aFalseList[j];
+    fClauseSum += aClauseWeight[iClause];
+    if (fRandClause < fClauseSum) {
+      break;
+    }
+  }
+  return(iClause);
+}
+
+
+void PickWalkSatUCTW() {
+
+  // weighted variant -- see PickWalkSatUCT for comments
+
+  UINT32 j;
+  FLOAT fScore;
+  UINT32 iClause;
+  UINT32 iClauseLen;
+  UINT32 iVar;
+  LITTYPE *pLit;
+  LITTYPE litPick;
+
+  iNumCandidates = 0;
+  fBestScore = fTotalWeight;
+
+  if (iNumFalse) {
+    iClause = PickClauseUCTW();
+  }
+  else {
+    iClause = iNumClauses;
+  }
+  
+  // If there are no false clauses that aren't preSat, terminate the run
+  if (iClause == iNumClauses) {
+    bTerminateRun = TRUE;
+    closedFlag = TRUE;
+    iFlipCandidate = 0;
+    return;
+  }
+  iClauseLen = aClauseLen[iClause];
+
+  pLit = pClauseLits[iClause];
+  for (j=0;j<iClauseLen;j++) {
+    iVar = GetVarFromLit(*pLit);
+    if (!IsMutable(iVar)) {
+      pLit++;
+      continue;
+    }
+    // the score is the weighted breakcount, kept up to date by Flip+MakeBreakUCTW
+    fScore = aBreakCountW[iVar];
+    if (fScore <= fBestScore) {
+      if (fScore < fBestScore) {
+        iNumCandidates=0;
+        fBestScore = fScore;
+      }
+      aCandidateList[iNumCandidates++] = iVar;
+    }
+    pLit++;
+  }
+  if (fBestScore > FLOATZERO) {
+    if (RandomProb(iWp)) {
+      litPick = pClauseLits[iClause][RandomInt(iClauseLen)];
+      iFlipCandidate = GetVarFromLit(litPick);
+      if (!IsMutable(iFlipCandidate)) {
+        iFlipCandidate=0;
+      }
+      return;
+    }
+  }
+  if (iNumCandidates > 1) {
+    iFlipCandidate = aCandidateList[RandomInt(iNumCandidates)];
+  } else {
+    iFlipCandidate = aCandidateList[0];
+  }
+}
+
+
+
 /***** NOVELTY for UCT *****/
 
 void AddNoveltyUCT() {
@@ -221,6 +340,24 @@ void AddNoveltyUCT() {
     PickNoveltyUCT,
     "",
     "");
+
+
+  pCurAlg = CreateAlgorithm(
+    "novelty","uct",TRUE,
+    "Novelty-UCT: Novelty with a set of immutable variables (weighted)",
+    "McAllester, Selman, Kautz [AAAI 97] (modified)",
+    "PickNoveltyUCTW",
+    "DefaultProceduresUCTW,Flip+FalseClauseListW,VarLastChange,BestFalse",
+    "default_w",
+    "default");
+  
+  CopyParameters(pCurAlg,"novelty","",FALSE);
+
+  CreateTrigger("PickNoveltyUCTW",
+    ChooseCandidate,
+    PickNoveltyUCTW,
+    "",
+    "");
 }
 
 
@@ -241,16 +378,32 @@ void PickNoveltyUCT() {
   UINT32 iSecondBestVar=0;
   UINT32 falseClauses[iNumClauses];
   int numFalseClauses = 0;
+  UINT32 w;
+  BITWORD bits;
 
   iBestScore = iNumClauses;
   iSecondBestScore = iNumClauses;
 
   // select an unsatisfied clause uniformly at random
   if (iNumFalse) {
-    // construct <falseClauses>
-    for (j=0; j<iNumClauses; j++) {
-      if (!preSat[j] && aNumTrueLit[j]==0)
-        falseClauses[numFalseClauses++] = j;
+    // construct <falseClauses>, skipping over preSat clauses a word at a time
+    for (w=0; w<BitsetWords(iNumClauses); w++) {
+      bits = ~preSat[w];
+      if (bits == BITWORDONES) {
+        for (j=(w << 6); j<((w+1) << 6); j++) {
+          if (aNumTrueLit[j]==0) {
+            falseClauses[numFalseClauses++] = j;
+          }
+        }
+        continue;
+      }
+      while (bits) {
+        j = (w << 6) + LowestBit(bits);
+        bits &= bits - 1;
+        if (aNumTrueLit[j]==0) {
+          falseClauses[numFalseClauses++] = j;
+        }
+      }
     }
     
     // If there are no false clauses that aren't preSat, terminate the run
@@ -277,7 +430,7 @@ void PickNoveltyUCT() {
   for (j=0;j<iClauseLen;j++) {
   
     iVar = GetVarFromLit(*pLit);
-    if (!varMutable[iVar]) {
+    if (!IsMutable(iVar)) {
       pLit++;
       continue;
     }
@@ -330,7 +483,7 @@ void PickNoveltyUCT() {
   iFlipCandidate = iBestVar;
 
   // if the best is the youngest, select it
-  if ((iFlipCandidate != iYoungestVar) || !varMutable[iSecondBestVar]) {
+  if ((iFlipCandidate != iYoungestVar) || !IsMutable(iSecondBestVar)) {
     return;
   }
 
@@ -343,6 +496,93 @@ void PickNoveltyUCT() {
 }
 
 
+void PickNoveltyUCTW() {
+
+  // weighted variant -- see PickNoveltyUCT for comments
+  
+  UINT32 i;
+  UINT32 j;
+  FLOAT fScore;
+  UINT32 iClause;
+  UINT32 iClauseLen;
+  LITTYPE *pLit;
+  UINT32 *pClause;
+  UINT32 iNumOcc;
+  UINT32 iVar;
+  UINT32 iYoungestVar;
+  FLOAT fSecondBestScore;
+  UINT32 iBestVar=0;
+  UINT32 iSecondBestVar=0;
+
+  fBestScore = fTotalWeight;
+  fSecondBestScore = fTotalWeight;
+
+  if (iNumFalse) {
+    iClause = PickClauseUCTW();
+    if (iClause == iNumClauses) {
+      bTerminateRun = TRUE;
+      closedFlag = TRUE;
+      iFlipCandidate = 0;
+      return;
+    }
+    iClauseLen = aClauseLen[iClause];
+  } else {
+    iFlipCandidate = 0;
+    closedFlag = TRUE;
+    return;
+  }
+
+  pLit = pClauseLits[iClause];
+  iYoungestVar = GetVarFromLit(*pLit);
+  for (j=0;j<iClauseLen;j++) {
+    iVar = GetVarFromLit(*pLit);
+    if (!IsMutable(iVar)) {
+      pLit++;
+      continue;
+    }
+    fScore = FLOATZERO;
+    iNumOcc = aNumLitOcc[*pLit];
+    pClause = pLitClause[*pLit];
+    for (i=0;i<iNumOcc;i++) {
+      if (aNumTrueLit[*pClause]==0) {
+        fScore -= aClauseWeight[*pClause];
+      }
+      pClause++;
+    }
+    iNumOcc = aNumLitOcc[GetNegatedLit(*pLit)];
+    pClause = pLitClause[GetNegatedLit(*pLit)];
+    for (i=0;i<iNumOcc;i++) {
+      if (aNumTrueLit[*pClause]==1) {
+        fScore += aClauseWeight[*pClause];
+      }
+      pClause++;
+    }
+    if (aVarLastChange[iVar] > aVarLastChange[iYoungestVar]) {
+      iYoungestVar = iVar;
+    }
+    if ((fScore < fBestScore) || ((fScore == fBestScore) && (aVarLastChange[iVar] < aVarLastChange[iBestVar]))) {
+      iSecondBestVar = iBestVar;
+      iBestVar = iVar;
+      fSecondBestScore = fBestScore;
+      fBestScore = fScore;
+    } else if ((fScore < fSecondBestScore) || ((fScore == fSecondBestScore) && (aVarLastChange[iVar] < aVarLastChange[iSecondBestVar]))) {
+      iSecondBestVar = iVar;
+      fSecondBestScore = fScore;
+    }
+    pLit++;
+  }
+  
+  iFlipCandidate = iBestVar;
+  if ((iFlipCandidate != iYoungestVar) || !IsMutable(iSecondBestVar)) {
+    return;
+  }
+  if (RandomProb(iNovNoise)) {
+    iFlipCandidate = iSecondBestVar;
+  }
+}
+
+
+
 /***** EXAMPLE 1: Adding a new algorithm variant *****/
 
 void AddWalkSatTabuNoNull() {
@@ -386,7 +626,7 @@ void PickWalkSatTabuNoNull() {
 
 /***** EXAMPLE 2: Adding a statistic *****/
 
-UINT32 iCurVarAge;    /* variable to store current variable age */
+THREADLOCAL UINT32 iCurVarAge;    /* variable to store current variable age */
 
 void AddAgeStat() {
                                                                   /* note that UInt refers to the data type of the _source_ */
@@ -165,9 +165,9 @@ void PickNoveltyPlusP() {
 }
 
 
-UINT32 *aIsLookAhead;
-UINT32 *aLookAheadList;
-SINT32 *aLookAheadScoreChange;
+THREADLOCAL UINT32 *aIsLookAhead;
+THREADLOCAL UINT32 *aLookAheadList;
+THREADLOCAL SINT32 *aLookAheadScoreChange;
 
 #define UpdateLookAhead(var,diff) {if(aIsLookAhead[var]==FALSE) {aIsLookAhead[var]=TRUE; aLookAheadList[iNumLookAhead++] = var; aLookAheadScoreChange[var] = (diff);} else {aLookAheadScoreChange[var] += (diff);}};
 
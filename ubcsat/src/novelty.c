@@ -22,8 +22,8 @@
 
 #include "ubcsat.h"
 
-PROBABILITY iNovNoise;
-PROBABILITY iDp;
+THREADLOCAL PROBABILITY iNovNoise;
+THREADLOCAL PROBABILITY iDp;
 
 void PickNovelty();
 void PickNoveltyPlus();
@@ -48,6 +48,7 @@ void AddParameters() {
   AddParmFloat(&parmUBCSAT,"-wtarget","weighted target solution quality","similar to -target, except the solution quality is the~sum of the weights of the false clauses","",&fTargetW,0);
   
   AddParmUInt(&parmUBCSAT,"-seed","specify an initial random seed","","",&iSeed,iSeed);
+  AddParmBool(&parmUBCSAT,"-legacyrand","use the Mersenne Twister with modulo sampling","the default generator is xoshiro256** with unbiased~multiply-shift sampling of bounded integers","LegacyRandom",&bLegacyRandom,FALSE);
   
   AddParmBool(&parmUBCSAT,"-solve","stop when a solution has been found and print solution","-solve may not complete all (-runs) specified~-solve also turns on the model report (-r model)","SolveMode",&bSolveMode,FALSE);
   AddParmUInt(&parmUBCSAT,"-find,-numsol","terminate after INT successful runs","-find may not complete all (-runs) specified~or may terminate before enough successful runs","",&iFind,0);
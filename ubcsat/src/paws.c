@@ -25,10 +25,10 @@
 void PickPAWS();
 void PostFlipPAWS();
 
-UINT32 iPAWSMaxInc;
-PROBABILITY iPAWSFlatMove;
+THREADLOCAL UINT32 iPAWSMaxInc;
+THREADLOCAL PROBABILITY iPAWSFlatMove;
 
-UINT32 iPawsSmoothCounter;
+THREADLOCAL UINT32 iPawsSmoothCounter;
 
 
 /***** Trigger PenClauseList *****/
@@ -36,9 +36,9 @@ UINT32 iPawsSmoothCounter;
 void CreatePenClauseList();
 void InitPenClauseList();
 
-UINT32 *aPenClauseList;
-UINT32 *aPenClauseListPos;
-UINT32 iNumPenClauseList;
+THREADLOCAL UINT32 *aPenClauseList;
+THREADLOCAL UINT32 *aPenClauseListPos;
+THREADLOCAL UINT32 iNumPenClauseList;
 
 void CreatePenClauseList() {
   aPenClauseList = AllocateRAM(iNumClauses*sizeof(UINT32));
@@ -22,40 +22,40 @@
 
 #include "ubcsat.h"
 
-REPORT *pRepHelp;
-REPORT *pRepErr;
-
-REPORT *pRepOut;
-REPORT *pRepRTD;
-REPORT *pRepStats;
-REPORT *pRepState;
-REPORT *pRepModel;
-REPORT *pRepSolution;
-REPORT *pRepUniqueSol;
-REPORT *pRepBestSol;
-REPORT *pRepBestStep;
-REPORT *pRepTrajBestLM;
-REPORT *pRepOptClauses;
-REPORT *pRepFalseHist;
-REPORT *pRepDistance;
-REPORT *pRepDistHist;
-REPORT *pRepCNFStats;
-REPORT *pRepFlipCounts;
-REPORT *pRepBiasCounts;
-REPORT *pRepUnsatCounts;
-REPORT *pRepVarLast;
-REPORT *pRepClauseLast;
-REPORT *pRepSQGrid;
-REPORT *pRepPenalty;
-REPORT *pRepPenMean;
-REPORT *pRepPenStddev;
-REPORT *pRepPenCV;
-REPORT *pRepMobility;
-REPORT *pRepMobFixed;
-REPORT *pRepMobFixedFreq;
-REPORT *pRepAutoCorr;
-REPORT *pRepTriggers;
-REPORT *pRepSATComp;
+THREADLOCAL REPORT *pRepHelp;
+THREADLOCAL REPORT *pRepErr;
+
+THREADLOCAL REPORT *pRepOut;
+THREADLOCAL REPORT *pRepRTD;
+THREADLOCAL REPORT *pRepStats;
+THREADLOCAL REPORT *pRepState;
+THREADLOCAL REPORT *pRepModel;
+THREADLOCAL REPORT *pRepSolution;
+THREADLOCAL REPORT *pRepUniqueSol;
+THREADLOCAL REPORT *pRepBestSol;
+THREADLOCAL REPORT *pRepBestStep;
+THREADLOCAL REPORT *pRepTrajBestLM;
+THREADLOCAL REPORT *pRepOptClauses;
+THREADLOCAL REPORT *pRepFalseHist;
+THREADLOCAL REPORT *pRepDistance;
+THREADLOCAL REPORT *pRepDistHist;
+THREADLOCAL REPORT *pRepCNFStats;
+THREADLOCAL REPORT *pRepFlipCounts;
+THREADLOCAL REPORT *pRepBiasCounts;
+THREADLOCAL REPORT *pRepUnsatCounts;
+THREADLOCAL REPORT *pRepVarLast;
+THREADLOCAL REPORT *pRepClauseLast;
+THREADLOCAL REPORT *pRepSQGrid;
+THREADLOCAL REPORT *pRepPenalty;
+THREADLOCAL REPORT *pRepPenMean;
+THREADLOCAL REPORT *pRepPenStddev;
+THREADLOCAL REPORT *pRepPenCV;
+THREADLOCAL REPORT *pRepMobility;
+THREADLOCAL REPORT *pRepMobFixed;
+THREADLOCAL REPORT *pRepMobFixedFreq;
+THREADLOCAL REPORT *pRepAutoCorr;
+THREADLOCAL REPORT *pRepTriggers;
+THREADLOCAL REPORT *pRepSATComp;
 
 void AddReports() {
 
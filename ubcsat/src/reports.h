@@ -22,38 +22,38 @@
 
 void AddReports();
 
-extern REPORT *pRepHelp;
-extern REPORT *pRepErr;
+extern THREADLOCAL REPORT *pRepHelp;
+extern THREADLOCAL REPORT *pRepErr;
 
-extern REPORT *pRepOut;
-extern REPORT *pRepRTD;
-extern REPORT *pRepStats;
-extern REPORT *pRepState;
-extern REPORT *pRepModel;
-extern REPORT *pRepSolution;
-extern REPORT *pRepUniqueSol;
-extern REPORT *pRepBestSol;
-extern REPORT *pRepBestStep;
-extern REPORT *pRepTrajBestLM;
-extern REPORT *pRepOptClauses;
-extern REPORT *pRepFalseHist;
-extern REPORT *pRepDistance;
-extern REPORT *pRepDistHist;
-extern REPORT *pRepCNFStats;
-extern REPORT *pRepFlipCounts;
-extern REPORT *pRepBiasCounts;
-extern REPORT *pRepUnsatCounts;
-extern REPORT *pRepVarLast;
-extern REPORT *pRepClauseLast;
-extern REPORT *pRepSQGrid;
-extern REPORT *pRepPenalty;
-extern REPORT *pRepPenMean;
-extern REPORT *pRepPenStddev;
-extern REPORT *pRepPenCV;
-extern REPORT *pRepMobility;
-extern REPORT *pRepMobFixed;
-extern REPORT *pRepMobFixedFreq;
-extern REPORT *pRepAutoCorr;
-extern REPORT *pRepTriggers;
-extern REPORT *pRepSATComp;
+extern THREADLOCAL REPORT *pRepOut;
+extern THREADLOCAL REPORT *pRepRTD;
+extern THREADLOCAL REPORT *pRepStats;
+extern THREADLOCAL REPORT *pRepState;
+extern THREADLOCAL REPORT *pRepModel;
+extern THREADLOCAL REPORT *pRepSolution;
+extern THREADLOCAL REPORT *pRepUniqueSol;
+extern THREADLOCAL REPORT *pRepBestSol;
+extern THREADLOCAL REPORT *pRepBestStep;
+extern THREADLOCAL REPORT *pRepTrajBestLM;
+extern THREADLOCAL REPORT *pRepOptClauses;
+extern THREADLOCAL REPORT *pRepFalseHist;
+extern THREADLOCAL REPORT *pRepDistance;
+extern THREADLOCAL REPORT *pRepDistHist;
+extern THREADLOCAL REPORT *pRepCNFStats;
+extern THREADLOCAL REPORT *pRepFlipCounts;
+extern THREADLOCAL REPORT *pRepBiasCounts;
+extern THREADLOCAL REPORT *pRepUnsatCounts;
+extern THREADLOCAL REPORT *pRepVarLast;
+extern THREADLOCAL REPORT *pRepClauseLast;
+extern THREADLOCAL REPORT *pRepSQGrid;
+extern THREADLOCAL REPORT *pRepPenalty;
+extern THREADLOCAL REPORT *pRepPenMean;
+extern THREADLOCAL REPORT *pRepPenStddev;
+extern THREADLOCAL REPORT *pRepPenCV;
+extern THREADLOCAL REPORT *pRepMobility;
+extern THREADLOCAL REPORT *pRepMobFixed;
+extern THREADLOCAL REPORT *pRepMobFixedFreq;
+extern THREADLOCAL REPORT *pRepAutoCorr;
+extern THREADLOCAL REPORT *pRepTriggers;
+extern THREADLOCAL REPORT *pRepSATComp;
 
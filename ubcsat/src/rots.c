@@ -22,9 +22,9 @@
 
 #include "ubcsat.h"
 
-UINT32 iTabuTenureInterval;
-UINT32 iTabuTenureLow;
-UINT32 iTabuTenureHigh;
+THREADLOCAL UINT32 iTabuTenureInterval;
+THREADLOCAL UINT32 iTabuTenureLow;
+THREADLOCAL UINT32 iTabuTenureHigh;
 
 void InitRoTS();
 void PickRoTS();
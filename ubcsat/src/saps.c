@@ -22,11 +22,11 @@
 
 #include "ubcsat.h"
 
-FLOAT fAlpha;
-FLOAT fRho;
-FLOAT fPenaltyImprove;
-PROBABILITY iPs;
-PROBABILITY iRPs;
+THREADLOCAL FLOAT fAlpha;
+THREADLOCAL FLOAT fRho;
+THREADLOCAL FLOAT fPenaltyImprove;
+THREADLOCAL PROBABILITY iPs;
+THREADLOCAL PROBABILITY iRPs;
 
 const FLOAT fMaxClausePenalty = 1000.0f;
 
@@ -0,0 +1,28 @@
+/* Bitsets used by the UCT variants
+ *
+ * A bitset of N entries is stored in BitsetWords(N) 64-bit words, entry i being bit (i & 63)
+ * of word (i >> 6). Resetting a whole set is a memset over N/64 words, and scans can skip
+ * 64 entries at a time with popcount / count-trailing-zeros.
+ */
+
+#ifndef UBCSAT_BITSET
+
+#define UBCSAT_BITSET
+
+#define BITWORD unsigned long long
+#define BITWORDBITS 64
+#define BITWORDONES (~0ULL)
+
+#define BitsetWords(N) (((N) + BITWORDBITS - 1) / BITWORDBITS)
+
+#define GetBit(B,I) (((B)[(I) >> 6] >> ((I) & 63)) & 1ULL)
+#define SetBit(B,I) ((B)[(I) >> 6] |= (1ULL << ((I) & 63)))
+#define ClearBit(B,I) ((B)[(I) >> 6] &= ~(1ULL << ((I) & 63)))
+
+#define SetAllBits(B,N) memset((B), 0xFF, BitsetWords(N) * sizeof(BITWORD))
+#define ClearAllBits(B,N) memset((B), 0x00, BitsetWords(N) * sizeof(BITWORD))
+
+#define BitCount(W) __builtin_popcountll(W)
+#define LowestBit(W) __builtin_ctzll(W)
+
+#endif
@@ -73,51 +73,51 @@
 
 extern const char sNull;
 
-extern char *sAlgName;
-extern char *sVarName;
-extern BOOL bWeighted;
+extern THREADLOCAL char *sAlgName;
+extern THREADLOCAL char *sVarName;
+extern THREADLOCAL BOOL bWeighted;
 
-extern ALGORITHM *pActiveAlgorithm;
+extern THREADLOCAL ALGORITHM *pActiveAlgorithm;
 
-extern UINT32 iNumRuns;
-extern UINT32 iCutoff;
-extern FLOAT fTimeOut;
-extern FLOAT fGlobalTimeOut;
-extern UINT32 iSeed;
+extern THREADLOCAL UINT32 iNumRuns;
+extern THREADLOCAL UINT32 iCutoff;
+extern THREADLOCAL FLOAT fTimeOut;
+extern THREADLOCAL FLOAT fGlobalTimeOut;
+extern THREADLOCAL UINT32 iSeed;
 
-extern UINT32 iTarget;
-extern FLOAT fTargetW;
+extern THREADLOCAL UINT32 iTarget;
+extern THREADLOCAL FLOAT fTargetW;
 
-extern UINT32 iFlipCandidate;
+extern THREADLOCAL UINT32 iFlipCandidate;
 
-extern UINT32 iFind;
-extern UINT32 iNumSolutionsFound;
-extern UINT32 iFindUnique;
-extern UINT32 iPeriodicRestart;
-extern PROBABILITY iProbRestart;
-extern UINT32 iStagnateRestart;
+extern THREADLOCAL UINT32 iFind;
+extern THREADLOCAL UINT32 iNumSolutionsFound;
+extern THREADLOCAL UINT32 iFindUnique;
+extern THREADLOCAL UINT32 iPeriodicRestart;
+extern THREADLOCAL PROBABILITY iProbRestart;
+extern THREADLOCAL UINT32 iStagnateRestart;
 
-extern BOOL bRestart;
+extern THREADLOCAL BOOL bRestart;
 
-extern UINT32 iRun;
-extern UINT32 iStep;
+extern THREADLOCAL UINT32 iRun;
+extern THREADLOCAL UINT32 iStep;
 
-extern BOOL bTerminateAllRuns;
-extern BOOL bSolutionFound;
-extern BOOL bTerminateRun;
+extern THREADLOCAL BOOL bTerminateAllRuns;
+extern THREADLOCAL BOOL bSolutionFound;
+extern THREADLOCAL BOOL bTerminateRun;
 
-extern BOOL bSolveMode;
+extern THREADLOCAL BOOL bSolveMode;
 
-extern char *sFilenameIn;
-extern char *sFilenameParms;
-extern char *sFilenameVarInit;
+extern THREADLOCAL char *sFilenameIn;
+extern THREADLOCAL char *sFilenameParms;
+extern THREADLOCAL char *sFilenameVarInit;
 
-extern BOOL bReportEcho;
-extern BOOL bReportClean;
-extern BOOL bReportFlush;
+extern THREADLOCAL BOOL bReportEcho;
+extern THREADLOCAL BOOL bReportClean;
+extern THREADLOCAL BOOL bReportFlush;
 
-extern SINT32 iBestScore;
-extern FLOAT fBestScore;
+extern THREADLOCAL SINT32 iBestScore;
+extern THREADLOCAL FLOAT fBestScore;
 
 
 /***** UBCSAT GLOBAL ROUTINES *****/
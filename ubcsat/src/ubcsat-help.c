@@ -26,15 +26,15 @@
   This file contains routines for displaying help 
 */
 
-BOOL bShowHelp;
-BOOL bShowHelpA;
-BOOL bShowHelpW;
-BOOL bShowHelpP;
-BOOL bShowHelpV;
-BOOL bShowHelpT;
-BOOL bShowHelpR;
-BOOL bShowHelpC;
-BOOL bShowHelpS;
+THREADLOCAL BOOL bShowHelp;
+THREADLOCAL BOOL bShowHelpA;
+THREADLOCAL BOOL bShowHelpW;
+THREADLOCAL BOOL bShowHelpP;
+THREADLOCAL BOOL bShowHelpV;
+THREADLOCAL BOOL bShowHelpT;
+THREADLOCAL BOOL bShowHelpR;
+THREADLOCAL BOOL bShowHelpC;
+THREADLOCAL BOOL bShowHelpS;
 
 void HelpNoAlgorithm();
 void HelpBadReport();
@@ -70,7 +70,7 @@ void CheckPrintHelp() {
   if (!pActiveAlgorithm) HelpNoAlgorithm();
 }
 
-BOOL bHelpHeaderShown;
+THREADLOCAL BOOL bHelpHeaderShown;
 
 void HelpShowHeader() {
   if (bHelpHeaderShown) {
@@ -347,7 +347,7 @@ void HelpPrintStats() {
 
 }
 
-char sHelpString[HELPSTRINGLENGTH];
+THREADLOCAL char sHelpString[HELPSTRINGLENGTH];
 
 void SetHelpStringAlg(ALGORITHM *pAlg) {
 
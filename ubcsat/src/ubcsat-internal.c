@@ -32,89 +32,89 @@
 
 const char *sValidStatCodes[NUMVALIDSTATCODES] = {"all","mean","stddev","cv","var","stderr","vmr","sum","median","min","max","q05","q10","q25","q75","q90","q95","q98","qr75/25","qr90/10","qr95/05","stepmean","solvemean","failmean","solvemedian","failmedian","solvemin","failmin","solvemax","failmax"};
 
-UINT32 aActiveCalcColumns[MAXITEMLIST];
-FXNPTR aActiveProcedures[NUMEVENTPOINTS][MAXFXNLIST];
-ALGORITHM aAlgorithms[MAXNUMALG];
-REPORTCOL aColumns[MAXITEMLIST];
-DYNAMICPARM aDynamicParms[MAXDYNAMICPARMS];
-UINT32 aNumActiveProcedures[NUMEVENTPOINTS];
-UINT32 aOutputColumns[MAXITEMLIST];
-REPORT aReports[MAXREPORTS];
-UINT32 aRTDColumns[MAXITEMLIST];
-REPORTSTAT aStats[MAXITEMLIST];
-char **aTotalParms;
-TRIGGER aTriggers[MAXITEMLIST];
-BOOL aParmValid[MAXTOTALPARMS];
-BOOL bReportClean;
-BOOL bReportFlush;
-BOOL bReportEcho;
-BOOL bRestart;
-BOOL bSolutionFound;
-BOOL bSolveMode;
-BOOL bTerminateAllRuns;
-BOOL bTerminateRun;
-BOOL bWeighted;
-FLOAT fDummy;
-FLOAT fFlipsPerSecond;
-FLOAT fBestScore;
-FLOAT fTargetW;
-SINT32 iBestScore;
-UINT32 iCutoff;
-UINT32 iFind;
-UINT32 iFindUnique;
-UINT32 iFlipCandidate;
-UINT32 iNumActiveCalcColumns;
-UINT32 iNumAlg;
-UINT32 iNumDynamicParms;
-UINT32 iNumOutputColumns;
-UINT32 iNumReports;
-UINT32 iNumRTDColumns;
-UINT32 iNumRuns;
-UINT32 iNumSolutionsFound;
-UINT32 iNumStatsActive;
-UINT32 iNumTotalParms;
-UINT32 iPeriodicRestart;
-PROBABILITY iProbRestart;
-UINT32 iRun;
-UINT32 iRunProceduresLoop;
-UINT32 iRunProceduresLoop2;
-UINT32 iSeed;
-UINT32 iStagnateRestart;
-UINT32 iStep;
-UINT32 iTarget;
-FLOAT fTimeOut;
-FLOAT fGlobalTimeOut;
-ITEMLIST listColumns;
-ITEMLIST listStats;
-ITEMLIST listTriggers;
-ALGORITHM *pActiveAlgorithm;
-ALGPARMLIST parmAlg;
-ALGPARMLIST parmHelp;
-ALGPARMLIST parmIO;
-ALGPARMLIST parmUBCSAT;
-char *pVersion;
-char *sAlgName;
-char *sCommentString;
-char *sFilenameIn;
-char *sFilenameParms;
-char *sFilenameVarInit;
-char *sFilenameSoln;
-char sMasterString[MAXITEMLISTSTRINGLENGTH];
+THREADLOCAL UINT32 aActiveCalcColumns[MAXITEMLIST];
+THREADLOCAL FXNPTR aActiveProcedures[NUMEVENTPOINTS][MAXFXNLIST];
+THREADLOCAL ALGORITHM aAlgorithms[MAXNUMALG];
+THREADLOCAL REPORTCOL aColumns[MAXITEMLIST];
+THREADLOCAL DYNAMICPARM aDynamicParms[MAXDYNAMICPARMS];
+THREADLOCAL UINT32 aNumActiveProcedures[NUMEVENTPOINTS];
+THREADLOCAL UINT32 aOutputColumns[MAXITEMLIST];
+THREADLOCAL REPORT aReports[MAXREPORTS];
+THREADLOCAL UINT32 aRTDColumns[MAXITEMLIST];
+THREADLOCAL REPORTSTAT aStats[MAXITEMLIST];
+THREADLOCAL char **aTotalParms;
+THREADLOCAL TRIGGER aTriggers[MAXITEMLIST];
+THREADLOCAL BOOL aParmValid[MAXTOTALPARMS];
+THREADLOCAL BOOL bReportClean;
+THREADLOCAL BOOL bReportFlush;
+THREADLOCAL BOOL bReportEcho;
+THREADLOCAL BOOL bRestart;
+THREADLOCAL BOOL bSolutionFound;
+THREADLOCAL BOOL bSolveMode;
+THREADLOCAL BOOL bTerminateAllRuns;
+THREADLOCAL BOOL bTerminateRun;
+THREADLOCAL BOOL bWeighted;
+THREADLOCAL FLOAT fDummy;
+THREADLOCAL FLOAT fFlipsPerSecond;
+THREADLOCAL FLOAT fBestScore;
+THREADLOCAL FLOAT fTargetW;
+THREADLOCAL SINT32 iBestScore;
+THREADLOCAL UINT32 iCutoff;
+THREADLOCAL UINT32 iFind;
+THREADLOCAL UINT32 iFindUnique;
+THREADLOCAL UINT32 iFlipCandidate;
+THREADLOCAL UINT32 iNumActiveCalcColumns;
+THREADLOCAL UINT32 iNumAlg;
+THREADLOCAL UINT32 iNumDynamicParms;
+THREADLOCAL UINT32 iNumOutputColumns;
+THREADLOCAL UINT32 iNumReports;
+THREADLOCAL UINT32 iNumRTDColumns;
+THREADLOCAL UINT32 iNumRuns;
+THREADLOCAL UINT32 iNumSolutionsFound;
+THREADLOCAL UINT32 iNumStatsActive;
+THREADLOCAL UINT32 iNumTotalParms;
+THREADLOCAL UINT32 iPeriodicRestart;
+THREADLOCAL PROBABILITY iProbRestart;
+THREADLOCAL UINT32 iRun;
+THREADLOCAL UINT32 iRunProceduresLoop;
+THREADLOCAL UINT32 iRunProceduresLoop2;
+THREADLOCAL UINT32 iSeed;
+THREADLOCAL UINT32 iStagnateRestart;
+THREADLOCAL UINT32 iStep;
+THREADLOCAL UINT32 iTarget;
+THREADLOCAL FLOAT fTimeOut;
+THREADLOCAL FLOAT fGlobalTimeOut;
+THREADLOCAL ITEMLIST listColumns;
+THREADLOCAL ITEMLIST listStats;
+THREADLOCAL ITEMLIST listTriggers;
+THREADLOCAL ALGORITHM *pActiveAlgorithm;
+THREADLOCAL ALGPARMLIST parmAlg;
+THREADLOCAL ALGPARMLIST parmHelp;
+THREADLOCAL ALGPARMLIST parmIO;
+THREADLOCAL ALGPARMLIST parmUBCSAT;
+THREADLOCAL char *pVersion;
+THREADLOCAL char *sAlgName;
+THREADLOCAL char *sCommentString;
+THREADLOCAL char *sFilenameIn;
+THREADLOCAL char *sFilenameParms;
+THREADLOCAL char *sFilenameVarInit;
+THREADLOCAL char *sFilenameSoln;
+THREADLOCAL char sMasterString[MAXITEMLISTSTRINGLENGTH];
 const char sNull = 0;
-char sParmLine[MAXPARMLINELEN];
-char sStringParm[MAXPARMLINELEN];
-char *sVarName;
-
-BOOL bReportStateLMOnly;
-FLOAT fReportStateQuality;
-BOOL bReportBestStepVars;
-BOOL bReportOptClausesSol;
-UINT32 iReportFalseHistCount;
-BOOL bReportDistanceLMOnly;
-UINT32 iReportDistHistCount;
-BOOL bReportStateQuality;
-UINT32 iReportStateQuality;
-BOOL bReportTriggersAll;
+THREADLOCAL char sParmLine[MAXPARMLINELEN];
+THREADLOCAL char sStringParm[MAXPARMLINELEN];
+THREADLOCAL char *sVarName;
+
+THREADLOCAL BOOL bReportStateLMOnly;
+THREADLOCAL FLOAT fReportStateQuality;
+THREADLOCAL BOOL bReportBestStepVars;
+THREADLOCAL BOOL bReportOptClausesSol;
+THREADLOCAL UINT32 iReportFalseHistCount;
+THREADLOCAL BOOL bReportDistanceLMOnly;
+THREADLOCAL UINT32 iReportDistHistCount;
+THREADLOCAL BOOL bReportStateQuality;
+THREADLOCAL UINT32 iReportStateQuality;
+THREADLOCAL BOOL bReportTriggersAll;
 
 void AddContainerItem(ITEMLIST *pList,const char *sID, const char *sList);
 void AddItem(ITEMLIST *pList,const char *sID);
@@ -1616,10 +1616,12 @@ void SetupUBCSAT() {
   iNumStatsActive = 0;
   iNumUniqueSolutions = 0;
 
-  iNumVars = 0;
-  iNumClauses = 0;
-  iNumLits = 0;
-  iVARSTATELen = 0;
+  if (!bInstanceShared) {
+    iNumVars = 0;
+    iNumClauses = 0;
+    iNumLits = 0;
+    iVARSTATELen = 0;
+  }
 
   iNumHeap = 0;
 
@@ -31,95 +31,95 @@
 #define NUMVALIDSTATCODES 30
 extern const char *sValidStatCodes[];
 
-extern ALGORITHM aAlgorithms[];
-
-extern ALGPARMLIST parmAlg;
-extern ALGPARMLIST parmHelp;
-extern ALGPARMLIST parmIO;
-extern ALGPARMLIST parmUBCSAT;
-
-extern BOOL bShowHelp;
-extern BOOL bShowHelpA;
-extern BOOL bShowHelpW;
-extern BOOL bShowHelpP;
-extern BOOL bShowHelpV;
-extern BOOL bShowHelpT;
-extern BOOL bShowHelpR;
-extern BOOL bShowHelpC;
-extern BOOL bShowHelpS;
-extern BOOL bHelpHeaderShown;
+extern THREADLOCAL ALGORITHM aAlgorithms[];
+
+extern THREADLOCAL ALGPARMLIST parmAlg;
+extern THREADLOCAL ALGPARMLIST parmHelp;
+extern THREADLOCAL ALGPARMLIST parmIO;
+extern THREADLOCAL ALGPARMLIST parmUBCSAT;
+
+extern THREADLOCAL BOOL bShowHelp;
+extern THREADLOCAL BOOL bShowHelpA;
+extern THREADLOCAL BOOL bShowHelpW;
+extern THREADLOCAL BOOL bShowHelpP;
+extern THREADLOCAL BOOL bShowHelpV;
+extern THREADLOCAL BOOL bShowHelpT;
+extern THREADLOCAL BOOL bShowHelpR;
+extern THREADLOCAL BOOL bShowHelpC;
+extern THREADLOCAL BOOL bShowHelpS;
+extern THREADLOCAL BOOL bHelpHeaderShown;
 
 extern const char sVersion[];
-extern char *pVersion;
-extern char *sCommentString;
-extern FXNPTR aActiveProcedures[][MAXFXNLIST];
-
-extern BOOL bReportOutputSuppress;
-
-extern BOOL bReportStateLMOnly;
-extern BOOL bReportDistanceLMOnly;
-extern FLOAT fReportStateQuality;
-extern BOOL bReportBestStepVars;
-extern BOOL bReportOptClausesSol;
-extern UINT32 iReportFalseHistCount;
-extern BOOL bReportDistanceLMOnly;
-extern UINT32 iReportDistHistCount;
-extern BOOL bReportStateQuality;
-extern UINT32 iReportStateQuality;
-
-extern BOOL bReportPenaltyEveryLM;
-extern BOOL bReportPenaltyReNormBase;
-extern BOOL bReportPenaltyReNormFraction;
-
-extern BOOL bReportTriggersAll;
-
-extern FLOAT fDummy;
-extern FLOAT fFlipsPerSecond;
-extern FLOAT fPercentSuccess;
-extern char *sStringAlgParms;
-
-extern ITEMLIST listColumns;
-extern ITEMLIST listStats;
-extern ITEMLIST listTriggers;
-
-extern REPORT aReports[];
-extern REPORTCOL aColumns[];
-extern DYNAMICPARM aDynamicParms[];
-extern REPORTSTAT aStats[];
-extern TRIGGER aTriggers[];
-
-extern UINT32 aNumActiveProcedures[];
-
-extern UINT32 aActiveCalcColumns[];
-extern UINT32 aOutputColumns[];
-extern UINT32 aRTDColumns[];
-
-extern UINT32 iMobFixedWindow;
-extern BOOL bMobilityFixedIncludeStart;
-extern UINT32 iNumActiveCalcColumns;
-extern UINT32 iNumAlg;
-extern UINT32 iNumDynamicParms;
-extern UINT32 iNumOutputColumns;
-extern UINT32 iNumReports;
-extern UINT32 iNumRTDColumns;
-extern UINT32 iNumStatsActive;
-extern UINT32 iReportMobilityDisplay;
-extern BOOL bReportMobilityNormalized;
-extern UINT32 iRunProceduresLoop;
-extern UINT32 iRunProceduresLoop2;
-extern BOOL bSortedByStepsValid;
-
-extern BOOL bMobilityColNActive;
-extern BOOL bMobilityColXActive;
-extern FLOAT fMobilityColNMean;
-extern FLOAT fMobilityColXMean;
-extern FLOAT fMobilityColNMeanNorm;
-extern FLOAT fMobilityColXMeanNorm;
-extern FLOAT fMobilityColNCV;
-extern FLOAT fMobilityColXCV;
-
-extern char *sFilenameSoln;
-extern char sLine[];
+extern THREADLOCAL char *pVersion;
+extern THREADLOCAL char *sCommentString;
+extern THREADLOCAL FXNPTR aActiveProcedures[][MAXFXNLIST];
+
+extern THREADLOCAL BOOL bReportOutputSuppress;
+
+extern THREADLOCAL BOOL bReportStateLMOnly;
+extern THREADLOCAL BOOL bReportDistanceLMOnly;
+extern THREADLOCAL FLOAT fReportStateQuality;
+extern THREADLOCAL BOOL bReportBestStepVars;
+extern THREADLOCAL BOOL bReportOptClausesSol;
+extern THREADLOCAL UINT32 iReportFalseHistCount;
+extern THREADLOCAL BOOL bReportDistanceLMOnly;
+extern THREADLOCAL UINT32 iReportDistHistCount;
+extern THREADLOCAL BOOL bReportStateQuality;
+extern THREADLOCAL UINT32 iReportStateQuality;
+
+extern THREADLOCAL BOOL bReportPenaltyEveryLM;
+extern THREADLOCAL BOOL bReportPenaltyReNormBase;
+extern THREADLOCAL BOOL bReportPenaltyReNormFraction;
+
+extern THREADLOCAL BOOL bReportTriggersAll;
+
+extern THREADLOCAL FLOAT fDummy;
+extern THREADLOCAL FLOAT fFlipsPerSecond;
+extern THREADLOCAL FLOAT fPercentSuccess;
+extern THREADLOCAL char *sStringAlgParms;
+
+extern THREADLOCAL ITEMLIST listColumns;
+extern THREADLOCAL ITEMLIST listStats;
+extern THREADLOCAL ITEMLIST listTriggers;
+
+extern THREADLOCAL REPORT aReports[];
+extern THREADLOCAL REPORTCOL aColumns[];
+extern THREADLOCAL DYNAMICPARM aDynamicParms[];
+extern THREADLOCAL REPORTSTAT aStats[];
+extern THREADLOCAL TRIGGER aTriggers[];
+
+extern THREADLOCAL UINT32 aNumActiveProcedures[];
+
+extern THREADLOCAL UINT32 aActiveCalcColumns[];
+extern THREADLOCAL UINT32 aOutputColumns[];
+extern THREADLOCAL UINT32 aRTDColumns[];
+
+extern THREADLOCAL UINT32 iMobFixedWindow;
+extern THREADLOCAL BOOL bMobilityFixedIncludeStart;
+extern THREADLOCAL UINT32 iNumActiveCalcColumns;
+extern THREADLOCAL UINT32 iNumAlg;
+extern THREADLOCAL UINT32 iNumDynamicParms;
+extern THREADLOCAL UINT32 iNumOutputColumns;
+extern THREADLOCAL UINT32 iNumReports;
+extern THREADLOCAL UINT32 iNumRTDColumns;
+extern THREADLOCAL UINT32 iNumStatsActive;
+extern THREADLOCAL UINT32 iReportMobilityDisplay;
+extern THREADLOCAL BOOL bReportMobilityNormalized;
+extern THREADLOCAL UINT32 iRunProceduresLoop;
+extern THREADLOCAL UINT32 iRunProceduresLoop2;
+extern THREADLOCAL BOOL bSortedByStepsValid;
+
+extern THREADLOCAL BOOL bMobilityColNActive;
+extern THREADLOCAL BOOL bMobilityColXActive;
+extern THREADLOCAL FLOAT fMobilityColNMean;
+extern THREADLOCAL FLOAT fMobilityColXMean;
+extern THREADLOCAL FLOAT fMobilityColNMeanNorm;
+extern THREADLOCAL FLOAT fMobilityColXMeanNorm;
+extern THREADLOCAL FLOAT fMobilityColNCV;
+extern THREADLOCAL FLOAT fMobilityColXCV;
+
+extern THREADLOCAL char *sFilenameSoln;
+extern THREADLOCAL char sLine[];
 
 void ActivateDynamicParms();
 void ActivateAlgorithmTriggers();
@@ -33,18 +33,47 @@
   extern unsigned long genrand_int32();
   extern void init_genrand(unsigned long s);
 
-  FXNRAND32 fxnRandUInt32 = genrand_int32;
+  #define fxnRandLegacy genrand_int32
   #define fxnRandSeed(A) init_genrand(A)
 #else
   #ifdef WIN32
-    FXNRAND32 fxnRandUInt32 = (UINT32 (*)()) rand;
+    #define fxnRandLegacy ((UINT32 (*)()) rand)
     #define fxnRandSeed(A) srand(A)
   #else
-    FXNRAND32 fxnRandUInt32 = (UINT32 (*)()) random;
+    #define fxnRandLegacy ((UINT32 (*)()) random)
     #define fxnRandSeed(A) srandom(A)
   #endif
 #endif
 
+THREADLOCAL FXNRAND32 fxnRandUInt32 = XoshiroUInt32;
+THREADLOCAL BOOL bLegacyRandom;
+THREADLOCAL UINT64 aXoshiroState[4];
+
+UINT32 XoshiroUInt32() {
+  return(XoshiroNext());
+}
+
+/* the state is expanded from the seed with splitmix64, so it is never all zero */
+
+void XoshiroSeed(UINT32 iSeed) {
+  UINT64 iMix = iSeed;
+  UINT64 iZ;
+  int j;
+  for (j=0;j<4;j++) {
+    iMix += 0x9E3779B97F4A7C15ULL;
+    iZ = iMix;
+    iZ = (iZ ^ (iZ >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    iZ = (iZ ^ (iZ >> 27)) * 0x94D049BB133111EBULL;
+    aXoshiroState[j] = iZ ^ (iZ >> 31);
+  }
+}
+
+void SetupLegacyRandom() {
+  if (fxnRandUInt32 == XoshiroUInt32) {
+    fxnRandUInt32 = fxnRandLegacy;
+  }
+}
+
 FLOAT ProbToFloat(PROBABILITY iProb) {
   return (iProb*(1.0/4294967295.0));
 }
@@ -62,21 +91,17 @@ UINT32 ProbToInvInt(PROBABILITY iProb) {
 FLOAT RandomFloat() {
   UINT32 iNum;
   FLOAT fNum;
-  iNum = fxnRandUInt32();
+  iNum = RandomUInt32();
   fNum = (FLOAT) iNum;
   fNum /= 4294967295.0;
   return(fNum);
 }
 
-UINT32 RandomInt(UINT32 iMax) {
-  return(fxnRandUInt32() % iMax);
-}
-
 BOOL RandomProb(PROBABILITY iProb) {
   if (iProb==0) {
     return(FALSE);
   }
-  if (fxnRandUInt32() <= iProb) {
+  if (RandomUInt32() <= iProb) {
     return(TRUE);
   } else {
     return(FALSE);
@@ -84,15 +109,16 @@ BOOL RandomProb(PROBABILITY iProb) {
 }
 
 UINT32 RandomMax() {
-  return(fxnRandUInt32());
+  return(RandomUInt32());
 }
 
 void RandomSeed(UINT32 iSeed) {
   fxnRandSeed(iSeed);
+  XoshiroSeed(iSeed);
 }
 
-UINT32 iNumRandomCalls;
-FXNRAND32 fxnRandOrig;
+THREADLOCAL UINT32 iNumRandomCalls;
+THREADLOCAL FXNRAND32 fxnRandOrig;
 
 UINT32 CountRandom() {
   iNumRandomCalls++;
@@ -187,17 +213,17 @@ void CleanExit() {
   FreeRAM();
 }
 
-FILE *filReportPrint;
+THREADLOCAL FILE *filReportPrint;
 
 
-FILE *filRandomData;
-char *sFilenameRandomData;
-char *sFilenameAbort;
-BYTE *pRandomDataBuffer;
-UINT32 iRandomBufferRemaining;
-BYTE *pNextRandomData;
-BOOL bCycleData;
-UINT32 iCycleDataLen;
+THREADLOCAL FILE *filRandomData;
+THREADLOCAL char *sFilenameRandomData;
+THREADLOCAL char *sFilenameAbort;
+THREADLOCAL BYTE *pRandomDataBuffer;
+THREADLOCAL UINT32 iRandomBufferRemaining;
+THREADLOCAL BYTE *pNextRandomData;
+THREADLOCAL BOOL bCycleData;
+THREADLOCAL UINT32 iCycleDataLen;
 
 UINT32 FileRandomUInt32() {
   UINT32 iReturn = 0;
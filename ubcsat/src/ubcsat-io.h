@@ -22,10 +22,66 @@
 
 void RandomSeed(UINT32 iSeed);
 UINT32 RandomMax();
-UINT32 RandomInt(UINT32 iMax);
 BOOL RandomProb(PROBABILITY);
 FLOAT RandomFloat();
 
+/*
+    The default generator is xoshiro256** with per-thread state, inlined into the
+    flip loops; bounded integers come from Lemire's multiply-shift with rejection,
+    so they are unbiased and need no division in the common case.
+    -legacyrand selects the Mersenne Twister with modulo reduction instead
+*/
+
+extern THREADLOCAL BOOL bLegacyRandom;
+extern THREADLOCAL FXNRAND32 fxnRandUInt32;
+extern THREADLOCAL UINT64 aXoshiroState[4];
+
+UINT32 XoshiroUInt32();
+
+static inline UINT64 XoshiroRotl(UINT64 iX, int iK) {
+  return((iX << iK) | (iX >> (64 - iK)));
+}
+
+static inline UINT32 XoshiroNext() {
+  UINT64 iResult = XoshiroRotl(aXoshiroState[1] * 5, 7) * 9;
+  UINT64 iT = aXoshiroState[1] << 17;
+  aXoshiroState[2] ^= aXoshiroState[0];
+  aXoshiroState[3] ^= aXoshiroState[1];
+  aXoshiroState[1] ^= aXoshiroState[2];
+  aXoshiroState[0] ^= aXoshiroState[3];
+  aXoshiroState[2] ^= iT;
+  aXoshiroState[3] = XoshiroRotl(aXoshiroState[3], 45);
+  return((UINT32) (iResult >> 32));
+}
+
+/* the generator is only called through fxnRandUInt32 when a trigger has replaced it */
+
+static inline UINT32 RandomUInt32() {
+  if (fxnRandUInt32 == XoshiroUInt32) {
+    return(XoshiroNext());
+  }
+  return(fxnRandUInt32());
+}
+
+static inline UINT32 RandomInt(UINT32 iMax) {
+  UINT64 iProduct;
+  UINT32 iLow;
+  UINT32 iThreshold;
+  if (bLegacyRandom) {
+    return(RandomUInt32() % iMax);
+  }
+  iProduct = (UINT64) RandomUInt32() * iMax;
+  iLow = (UINT32) (iProduct & UINT32MAX);
+  if (iLow < iMax) {
+    iThreshold = (UINT32) (0x100000000ULL % iMax);
+    while (iLow < iThreshold) {
+      iProduct = (UINT64) RandomUInt32() * iMax;
+      iLow = (UINT32) (iProduct & UINT32MAX);
+    }
+  }
+  return((UINT32) (iProduct >> 32));
+}
+
 FLOAT ProbToFloat(PROBABILITY iProb);
 PROBABILITY FloatToProb(FLOAT fProb);
 UINT32 ProbToInvInt(PROBABILITY iProb);
@@ -38,13 +94,16 @@ void CloseSingleFile(FILE *filToClose);
 
 void SetupFile(FILE **fFil,const char *sOpenType, const char *sFilename, FILE *filDefault, BOOL bAllowNull);
 
-extern UINT32 iNumRandomCalls;
+extern THREADLOCAL UINT32 iNumRandomCalls;
 void SetupCountRandom();
 void InitCountRandom();
 
+void XoshiroSeed(UINT32 iSeed);
+void SetupLegacyRandom();
+
 void InitVarsFromFile();
 
-extern FILE *filReportPrint;
+extern THREADLOCAL FILE *filReportPrint;
 
 #define ReportPrint(pRep, sFormat) { filReportPrint = 0; if (pRep) filReportPrint = pRep->fileOut; if ((filReportPrint)&&(pRep->bActive)) fprintf(filReportPrint,sFormat); if ((bReportEcho) && (pRep->bActive) && (filReportPrint != stdout)) fprintf(stdout,sFormat); }
 #define ReportPrint1(pRep, sFormat, pVal1) { filReportPrint = 0; if (pRep) filReportPrint = pRep->fileOut; if ((filReportPrint)&&(pRep->bActive)) fprintf(filReportPrint,sFormat,pVal1); if ((bReportEcho) && (pRep->bActive) && (filReportPrint != stdout)) fprintf(stdout,sFormat,pVal1); }
@@ -57,8 +116,8 @@ extern FILE *filReportPrint;
 #define ReportHdrPrint1(pRep, sFormat, pVal1) { if (!bReportClean) { filReportPrint = 0; if (pRep) filReportPrint = pRep->fileOut; if ((filReportPrint)&&(pRep->bActive)) fprintf(filReportPrint,sFormat,pVal1); if ((bReportEcho) && (pRep->bActive) && (filReportPrint != stdout)) fprintf(stdout,sFormat,pVal1); }}
 #define ReportHdrPrint2(pRep, sFormat, pVal1, pVal2) { if (!bReportClean) { filReportPrint = 0; if (pRep) filReportPrint = pRep->fileOut; if ((filReportPrint)&&(pRep->bActive)) fprintf(filReportPrint,sFormat,pVal1,pVal2); if ((bReportEcho) && (pRep->bActive) && (filReportPrint != stdout)) fprintf(stdout,sFormat,pVal1,pVal2); }}
 
-extern char *sFilenameRandomData;
-extern char *sFilenameAbort;
+extern THREADLOCAL char *sFilenameRandomData;
+extern THREADLOCAL char *sFilenameAbort;
 void CreateFileRandom();
 void CloseFileRandom();
 void FileAbort();
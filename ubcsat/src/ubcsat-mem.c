@@ -27,9 +27,9 @@
 */
 
 
-UINT32 iNumHeap;
-size_t iLastRequestSize;
-UINT32 iLastHeap;
+THREADLOCAL UINT32 iNumHeap;
+THREADLOCAL size_t iLastRequestSize;
+THREADLOCAL UINT32 iLastHeap;
 
 typedef struct typeUBCSATHEAP {
   char *pHeap;
@@ -37,9 +37,20 @@ typedef struct typeUBCSATHEAP {
   size_t iBytesFree;
 } UBCSATHEAP;
 
-UBCSATHEAP aHeap[MAXHEAPS];
+THREADLOCAL UBCSATHEAP aHeap[MAXHEAPS];
 
-void *AllocateRAM( size_t size ) {
+/*  
+    The instance is shared by every thread, so it lives in heaps of its own
+    that outlast the per-thread heaps above
+*/
+
+UINT32 iNumSharedHeap;
+size_t iLastSharedRequestSize;
+UINT32 iLastSharedHeap;
+
+UBCSATHEAP aSharedHeap[MAXHEAPS];
+
+void *AllocateFromHeaps( UBCSATHEAP *aHeaps, UINT32 *piNumHeap, size_t *piLastRequestSize, UINT32 *piLastHeap, size_t size ) {
   UINT32 j;
   BOOL bFound;
   UINT32 iHeapID = 0;
@@ -47,12 +58,12 @@ void *AllocateRAM( size_t size ) {
 
   size = size + (4-(size % 4));
 
-  iLastRequestSize = size;
+  *piLastRequestSize = size;
   
   bFound = FALSE;
 
-  for (j=0;j<iNumHeap;j++) {
-    if (aHeap[j].iBytesFree >= size) {
+  for (j=0;j<*piNumHeap;j++) {
+    if (aHeaps[j].iBytesFree >= size) {
       bFound = TRUE;
       iHeapID = j;
       break;
@@ -60,33 +71,60 @@ void *AllocateRAM( size_t size ) {
   }
   if (!bFound) {
     if (size > DEFAULTHEAPSIZE) {
-      aHeap[iNumHeap].pHeap = malloc(size);
-      aHeap[iNumHeap].pFree = aHeap[iNumHeap].pHeap;
-      aHeap[iNumHeap].iBytesFree = size;
+      aHeaps[*piNumHeap].pHeap = malloc(size);
+      aHeaps[*piNumHeap].pFree = aHeaps[*piNumHeap].pHeap;
+      aHeaps[*piNumHeap].iBytesFree = size;
     } else {
-      aHeap[iNumHeap].pHeap = malloc(DEFAULTHEAPSIZE);
-      aHeap[iNumHeap].pFree = aHeap[iNumHeap].pHeap;
-      aHeap[iNumHeap].iBytesFree = DEFAULTHEAPSIZE;
+      aHeaps[*piNumHeap].pHeap = malloc(DEFAULTHEAPSIZE);
+      aHeaps[*piNumHeap].pFree = aHeaps[*piNumHeap].pHeap;
+      aHeaps[*piNumHeap].iBytesFree = DEFAULTHEAPSIZE;
     }
-    iHeapID = iNumHeap;
-    iNumHeap++;
-    if (iNumHeap == MAXHEAPS) {
+    iHeapID = *piNumHeap;
+    (*piNumHeap)++;
+    if (*piNumHeap == MAXHEAPS) {
       ReportPrint1(pRepErr,"Unexpected Error: increase constant MAXHEAPS [%u]\n",MAXHEAPS);
       AbnormalExit();
     }
   }
 
-  pReturn = (void *) aHeap[iHeapID].pFree;
-  aHeap[iHeapID].pFree += size;
-  aHeap[iHeapID].iBytesFree -= size;
-  iLastHeap = iHeapID;
+  pReturn = (void *) aHeaps[iHeapID].pFree;
+  aHeaps[iHeapID].pFree += size;
+  aHeaps[iHeapID].iBytesFree -= size;
+  *piLastHeap = iHeapID;
   return(pReturn);
 }
 
-void AdjustLastRAM( size_t size ) {
+void AdjustLastInHeaps( UBCSATHEAP *aHeaps, size_t iLastRequest, UINT32 iLast, size_t size ) {
   size = size + (4-(size % 4));
-  aHeap[iLastHeap].iBytesFree += (iLastRequestSize - size);
-  aHeap[iLastHeap].pFree -= (iLastRequestSize - size);
+  aHeaps[iLast].iBytesFree += (iLastRequest - size);
+  aHeaps[iLast].pFree -= (iLastRequest - size);
+}
+
+void FreeHeaps( UBCSATHEAP *aHeaps, UINT32 iNum ) {
+  
+  UINT32 j;
+
+  for (j=0;j<iNum;j++) {
+    if (aHeaps[j].pHeap) {
+      free(aHeaps[j].pHeap);
+    }
+  }
+}
+
+void *AllocateRAM( size_t size ) {
+  return(AllocateFromHeaps(aHeap,&iNumHeap,&iLastRequestSize,&iLastHeap,size));
+}
+
+void AdjustLastRAM( size_t size ) {
+  AdjustLastInHeaps(aHeap,iLastRequestSize,iLastHeap,size);
+}
+
+void *AllocateSharedRAM( size_t size ) {
+  return(AllocateFromHeaps(aSharedHeap,&iNumSharedHeap,&iLastSharedRequestSize,&iLastSharedHeap,size));
+}
+
+void AdjustLastSharedRAM( size_t size ) {
+  AdjustLastInHeaps(aSharedHeap,iLastSharedRequestSize,iLastSharedHeap,size);
 }
 
 void SetString(char **sNew, const char *sSrc) {
@@ -95,12 +133,10 @@ void SetString(char **sNew, const char *sSrc) {
 }
 
 void FreeRAM() {
-  
-  UINT32 j;
+  FreeHeaps(aHeap,iNumHeap);
+}
 
-  for (j=0;j<iNumHeap;j++) {
-    if (aHeap[j].pHeap) {
-      free(aHeap[j].pHeap);
-    }
-  }
+void FreeSharedRAM() {
+  FreeHeaps(aSharedHeap,iNumSharedHeap);
+  iNumSharedHeap = 0;
 }
@@ -26,4 +26,9 @@ void PrintMemUsage();
 void SetString(char **sNew, const char *sSrc);
 void FreeRAM();
 
-extern UINT32 iNumHeap;
+/* the instance, shared by all threads: freed once by FreeSharedRAM(), not by FreeRAM() */
+void *AllocateSharedRAM( size_t size );
+void AdjustLastSharedRAM( size_t size );
+void FreeSharedRAM();
+
+extern THREADLOCAL UINT32 iNumHeap;
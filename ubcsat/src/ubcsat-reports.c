@@ -28,7 +28,7 @@
 
 /***** Trigger ReportOut *****/
 
-BOOL bReportOutputSuppress;
+THREADLOCAL BOOL bReportOutputSuppress;
 
 void ReportOutSetup();
 void ReportOutSplash();
@@ -103,12 +103,12 @@ void ReportSQGridPrint();
 void ReportPenaltyCreate();
 void ReportPenaltyPrintStep();
 void ReportPenaltyPrintRun();
-BOOL bReportPenaltyReNormBase;
-BOOL bReportPenaltyReNormFraction;
-UINT32 bReportPenaltyEveryLM;
-FLOAT *aPenaltyStatsFinal;
-FLOAT *aPenaltyStatsFinalSum;
-FLOAT *aPenaltyStatsFinalSum2;
+THREADLOCAL BOOL bReportPenaltyReNormBase;
+THREADLOCAL BOOL bReportPenaltyReNormFraction;
+THREADLOCAL UINT32 bReportPenaltyEveryLM;
+THREADLOCAL FLOAT *aPenaltyStatsFinal;
+THREADLOCAL FLOAT *aPenaltyStatsFinalSum;
+THREADLOCAL FLOAT *aPenaltyStatsFinalSum2;
 
 /***** Trigger ReportPenMeanPrint *****/
 void ReportPenMeanPrint();
@@ -121,13 +121,13 @@ void ReportPenCVPrint();
 
 /***** Trigger ReportMobilityPrint *****/
 void ReportMobilityPrint();
-UINT32 iReportMobilityDisplay;
-BOOL bReportMobilityNormalized;
+THREADLOCAL UINT32 iReportMobilityDisplay;
+THREADLOCAL BOOL bReportMobilityNormalized;
 
 /***** Trigger ReportMobFixedPrint *****/
 void ReportMobFixedPrint();
-UINT32 iMobFixedWindow;
-BOOL bMobilityFixedIncludeStart;
+THREADLOCAL UINT32 iMobFixedWindow;
+THREADLOCAL BOOL bMobilityFixedIncludeStart;
 
 /***** Trigger ReportMobFixedFreqPrint *****/
 void ReportMobFixedFreqPrint();
@@ -149,7 +149,7 @@ void AllocateColumnRAM();
 
 /***** Trigger CalcPercentSolve *****/
 void CalcPercentSolve();
-FLOAT fPercentSuccess;
+THREADLOCAL FLOAT fPercentSuccess;
 
 /***** Trigger ColumnRunCalculation *****/
 void ColumnRunCalculation();
@@ -170,23 +170,23 @@ void UpdatePercents();
 void InitMobilityColumnN();
 void InitMobilityColumnX();
 void UpdateMobilityColumn();
-BOOL bMobilityColNActive;
-BOOL bMobilityColXActive;
-FLOAT fMobilityColNMean;
-FLOAT fMobilityColXMean;
-FLOAT fMobilityColNMeanNorm;
-FLOAT fMobilityColXMeanNorm;
-FLOAT fMobilityColNCV;
-FLOAT fMobilityColXCV;
+THREADLOCAL BOOL bMobilityColNActive;
+THREADLOCAL BOOL bMobilityColXActive;
+THREADLOCAL FLOAT fMobilityColNMean;
+THREADLOCAL FLOAT fMobilityColXMean;
+THREADLOCAL FLOAT fMobilityColNMeanNorm;
+THREADLOCAL FLOAT fMobilityColXMeanNorm;
+THREADLOCAL FLOAT fMobilityColNCV;
+THREADLOCAL FLOAT fMobilityColXCV;
 
 /***** Trigger UpdateTimes *****/
 void UpdateTimes();
 
 /***** Trigger SortByStepPerformance *****/
-UINT32 *aSortedBySteps;
-BOOL bSortedByStepsValid;
-UINT32 *aSortedByCurrent;
-UINT32 *aSortedByStepsAndFound;
+THREADLOCAL UINT32 *aSortedBySteps;
+THREADLOCAL BOOL bSortedByStepsValid;
+THREADLOCAL UINT32 *aSortedByCurrent;
+THREADLOCAL UINT32 *aSortedByStepsAndFound;
 void SortByCurrentColData(REPORTCOL *pCol);
 void SortByCurrentColDataAndFound(REPORTCOL *pCol);
 void SortByStepPerformance();
@@ -195,7 +195,7 @@ void SortByStepPerformance();
 void CalcFPS();
 
 /***** Trigger StringAlgParms *****/
-char *sStringAlgParms;
+THREADLOCAL char *sStringAlgParms;
 void StringAlgParms();
 
 void AddReportTriggers() {
@@ -2433,11 +2433,11 @@ void UpdateMobilityColumn() {
 
 /***** Trigger CompareSorted *****/
 
-REPORTCOL *pSortCol;
-UINT32 *aFoundData;
-UINT32 *auiSortColData;
-SINT32 *asiSortColData;
-FLOAT *afSortColData;
+THREADLOCAL REPORTCOL *pSortCol;
+THREADLOCAL UINT32 *aFoundData;
+THREADLOCAL UINT32 *auiSortColData;
+THREADLOCAL SINT32 *asiSortColData;
+THREADLOCAL FLOAT *afSortColData;
 
 int CompareSortedUInt(const void *a, const void *b) {
   UINT32 a1,b1;
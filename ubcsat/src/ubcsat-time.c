@@ -36,13 +36,16 @@ void StopRunClock();
 double TotalTimeElapsed();
 double RunTimeElapsed();
 
-double fTotalTime;
-double fRunTime;
+THREADLOCAL double fTotalTime;
+THREADLOCAL double fRunTime;
 
-double fStartTotalTimeStamp;
-double fStartRunTimeStamp;
+THREADLOCAL double fStartTotalTimeStamp;
+THREADLOCAL double fStartRunTimeStamp;
 
-double fCurrentTimeStamp;
+THREADLOCAL double fCurrentTimeStamp;
+
+THREADLOCAL double fDeadline;
+THREADLOCAL BOOL bDeadlineCPU;
 
 #ifdef WIN32
 
@@ -52,7 +55,6 @@ double fCurrentTimeStamp;
 
   struct timeval tv;
   struct timezone tzp;
-  struct tms prog_tms;
 
 #endif
 
@@ -63,6 +65,11 @@ double fCurrentTimeStamp;
     fCurrentTimeStamp = ((double) tstruct.time + ((double)tstruct.millitm)/1000.0);
   }
 
+  double DeadlineClock(BOOL bCPU) {
+    _ftime( &tstruct );
+    return ((double) tstruct.time + ((double)tstruct.millitm)/1000.0);
+  }
+
   void InitSeed() {
     _ftime( &tstruct );
     iSeed = (( ((UINT32) tstruct.time) & 0x001FFFFF ) * 1000) + tstruct.millitm;
@@ -71,8 +78,15 @@ double fCurrentTimeStamp;
 #else
 
   void CurrentTime() {
-    times(&prog_tms);
-    fCurrentTimeStamp = (double)prog_tms.tms_utime / ((double)sysconf(_SC_CLK_TCK));
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    fCurrentTimeStamp = (double)ts.tv_sec + (double)ts.tv_nsec/1e9;
+  }
+
+  double DeadlineClock(BOOL bCPU) {
+    struct timespec ts;
+    clock_gettime(bCPU ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec/1e9;
   }
 
   void InitSeed() {
@@ -122,3 +136,25 @@ void StopRunClock() {
   fRunTime = RunTimeElapsed();
 }
 
+/*
+    Deadlines are measured on the monotonic wall clock, or on the CPU clock of
+    the process if bCPU is set; DeadlinePassed() costs one clock read, so loops
+    should only call it every few hundred steps
+*/
+
+void SetDeadline(double fSeconds, BOOL bCPU) {
+  bDeadlineCPU = bCPU;
+  fDeadline = DeadlineClock(bCPU) + fSeconds;
+}
+
+void ClearDeadline() {
+  fDeadline = FLOATZERO;
+}
+
+BOOL DeadlinePassed() {
+  if (fDeadline <= FLOATZERO) {
+    return(FALSE);
+  }
+  return(DeadlineClock(bDeadlineCPU) >= fDeadline);
+}
+
@@ -26,6 +26,7 @@
 #include <unistd.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include <time.h>
 #endif
 
 void InitSeed();
@@ -39,7 +40,15 @@ void StopRunClock();
 double TotalTimeElapsed();
 double RunTimeElapsed();
 
-extern double fTotalTime;
-extern double fRunTime;
+extern THREADLOCAL double fTotalTime;
+extern THREADLOCAL double fRunTime;
+
+double DeadlineClock(BOOL bCPU);
+void SetDeadline(double fSeconds, BOOL bCPU);
+void ClearDeadline();
+BOOL DeadlinePassed();
+
+extern THREADLOCAL double fDeadline;
+extern THREADLOCAL BOOL bDeadlineCPU;
 
 
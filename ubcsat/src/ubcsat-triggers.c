@@ -39,9 +39,12 @@ LITTYPE **pClauseLits;
 
 FLOAT *aClauseWeight;
 FLOAT fTotalWeight;
+FLOAT fHardWeight;
 
 UINT32 iVARSTATELen;
 
+BOOL bInstanceShared;
+
 
 /***** Trigger LitOccurence *****/
 
@@ -56,9 +59,9 @@ UINT32 **pLitClause;
 
 void CreateCandidateList();
 
-UINT32 *aCandidateList;
-UINT32 iNumCandidates;
-UINT32 iMaxCandidates;
+THREADLOCAL UINT32 *aCandidateList;
+THREADLOCAL UINT32 iNumCandidates;
+THREADLOCAL UINT32 iMaxCandidates;
 
 
 /***** Trigger InitVarsFromFile *****/
@@ -69,9 +72,9 @@ void InitVarsFromFile();
 void DefaultInitVars();
 void DefaultInitVarsUCT();
 
-UINT32 *aVarInit;
-UINT32 iInitVarFlip;
-BOOL bVarInitGreedy;
+THREADLOCAL UINT32 *aVarInit;
+THREADLOCAL UINT32 iInitVarFlip;
+THREADLOCAL BOOL bVarInitGreedy;
 
 
 /***** Trigger DefaultStateInfo *****/
@@ -79,10 +82,10 @@ BOOL bVarInitGreedy;
 void CreateDefaultStateInfo();
 void InitDefaultStateInfo();
 
-UINT32 *aNumTrueLit;
-UINT32 *aVarValue;
-UINT32 iNumFalse;
-FLOAT fSumFalseW;
+THREADLOCAL UINT32 *aNumTrueLit;
+THREADLOCAL UINT32 *aVarValue;
+THREADLOCAL UINT32 iNumFalse;
+THREADLOCAL FLOAT fSumFalseW;
 
 
 /***** Trigger DefaultFlip[W] *****/
@@ -106,9 +109,9 @@ void InitFalseClauseList();
 void FlipFalseClauseList();
 void FlipFalseClauseListW();
 
-UINT32 *aFalseList;
-UINT32 *aFalseListPos;
-UINT32 iNumFalseList;
+THREADLOCAL UINT32 *aFalseList;
+THREADLOCAL UINT32 *aFalseListPos;
+THREADLOCAL UINT32 iNumFalseList;
 
 
 /***** Trigger VarScore[W] *****/
@@ -123,27 +126,37 @@ void InitVarScoreW();
 void UpdateVarScoreW();
 void FlipVarScoreW();
 
-SINT32 *aVarScore;
-FLOAT *aVarScoreW;
+THREADLOCAL SINT32 *aVarScore;
+THREADLOCAL FLOAT *aVarScoreW;
 
 
 /***** Trigger MakeBreak[W] *****/
 /***** Trigger Flip+MakeBreak[W] *****/
+/***** Trigger MakeBreakUCT *****/
+/***** Trigger Flip+MakeBreakUCT *****/
+/***** Trigger MakeBreakUCTW *****/
+/***** Trigger Flip+MakeBreakUCTW *****/
 
 void CreateMakeBreak();
 void InitMakeBreak();
 void UpdateMakeBreak();
 void FlipMakeBreak();
+void InitMakeBreakUCT();
+void UpdateMakeBreakUCT();
+void FlipMakeBreakUCT();
 void CreateMakeBreakW();
 void InitMakeBreakW();
 void UpdateMakeBreakW();
 void FlipMakeBreakW();
+void InitMakeBreakUCTW();
+void UpdateMakeBreakUCTW();
+void FlipMakeBreakUCTW();
 
-UINT32 *aBreakCount;
-UINT32 *aMakeCount;
-UINT32 *aCritSat;
-FLOAT *aBreakCountW;
-FLOAT *aMakeCountW;
+THREADLOCAL UINT32 *aBreakCount;
+THREADLOCAL UINT32 *aMakeCount;
+THREADLOCAL UINT32 *aCritSat;
+THREADLOCAL FLOAT *aBreakCountW;
+THREADLOCAL FLOAT *aMakeCountW;
 
 
 /***** Trigger VarInFalse *****/
@@ -159,9 +172,9 @@ void InitVarInFalse();
 void UpdateVarInFalse();
 void FlipVarInFalse();
 
-UINT32 iNumVarsInFalseList;
-UINT32 *aVarInFalseList;
-UINT32 *aVarInFalseListPos;
+THREADLOCAL UINT32 iNumVarsInFalseList;
+THREADLOCAL UINT32 *aVarInFalseList;
+THREADLOCAL UINT32 *aVarInFalseListPos;
 
 
 /***** Trigger VarLastChange *****/
@@ -173,8 +186,8 @@ void CreateVarLastChange();
 void InitVarLastChange();
 void UpdateVarLastChange();
 
-UINT32 *aVarLastChange;
-UINT32 iVarLastChangeReset;
+THREADLOCAL UINT32 *aVarLastChange;
+THREADLOCAL UINT32 iVarLastChangeReset;
 
 
 /***** Trigger TrackChanges[W] *****/
@@ -197,15 +210,15 @@ void UpdateTrackChangesW();
 void FlipTrackChangesW();
 void FlipTrackChangesFCLW();
 
-UINT32 iNumChanges;
-UINT32 *aChangeList;
-SINT32 *aChangeOldScore;
-UINT32 *aChangeLastStep;
+THREADLOCAL UINT32 iNumChanges;
+THREADLOCAL UINT32 *aChangeList;
+THREADLOCAL SINT32 *aChangeOldScore;
+THREADLOCAL UINT32 *aChangeLastStep;
 
-UINT32 iNumChangesW;
-UINT32 *aChangeListW;
-FLOAT *aChangeOldScoreW;
-UINT32 *aChangeLastStepW;
+THREADLOCAL UINT32 iNumChangesW;
+THREADLOCAL UINT32 *aChangeListW;
+THREADLOCAL FLOAT *aChangeOldScoreW;
+THREADLOCAL UINT32 *aChangeLastStepW;
 
 
 /***** Trigger DecPromVars[W] *****/
@@ -218,11 +231,11 @@ void CreateDecPromVarsW();
 void InitDecPromVarsW();
 void UpdateDecPromVarsW();
 
-UINT32 *aDecPromVarsList;
-UINT32 iNumDecPromVars;
+THREADLOCAL UINT32 *aDecPromVarsList;
+THREADLOCAL UINT32 iNumDecPromVars;
 
-UINT32 *aDecPromVarsListW;
-UINT32 iNumDecPromVarsW;
+THREADLOCAL UINT32 *aDecPromVarsListW;
+THREADLOCAL UINT32 iNumDecPromVarsW;
 
 
 /***** Trigger BestScoreList *****/
@@ -231,9 +244,9 @@ void CreateBestScoreList();
 void InitBestScoreList();
 void UpdateBestScoreList();
 
-UINT32 iNumBestScoreList;
-UINT32 *aBestScoreList;
-UINT32 *aBestScoreListPos;
+THREADLOCAL UINT32 iNumBestScoreList;
+THREADLOCAL UINT32 *aBestScoreList;
+THREADLOCAL UINT32 *aBestScoreListPos;
 
 
 /***** Trigger ClausePenaltyFL[W] *****/
@@ -242,11 +255,11 @@ void CreateClausePenaltyFL();
 void InitClausePenaltyFL();
 void InitClausePenaltyFLW();
 
-FLOAT *aClausePenaltyFL;
-BOOL bClausePenaltyCreated;
-BOOL bClausePenaltyFLOAT;
-FLOAT fBasePenaltyFL;
-FLOAT fTotalPenaltyFL;
+THREADLOCAL FLOAT *aClausePenaltyFL;
+THREADLOCAL BOOL bClausePenaltyCreated;
+THREADLOCAL BOOL bClausePenaltyFLOAT;
+THREADLOCAL FLOAT fBasePenaltyFL;
+THREADLOCAL FLOAT fTotalPenaltyFL;
 
 
 
@@ -258,8 +271,8 @@ void UpdateMakeBreakPenaltyFL();
 void FlipMBPFLandFCLandVIF();
 void FlipMBPFLandFCLandVIFandW();
 
-FLOAT *aMakePenaltyFL;
-FLOAT *aBreakPenaltyFL;
+THREADLOCAL FLOAT *aMakePenaltyFL;
+THREADLOCAL FLOAT *aBreakPenaltyFL;
 
 
 /***** Trigger ClausePenaltyINT *****/
@@ -268,10 +281,10 @@ void CreateClausePenaltyINT();
 void InitClausePenaltyINT();
 void InitClausePenaltyINTW();
 
-UINT32 *aClausePenaltyINT;
-UINT32 iInitPenaltyINT;
-UINT32 iBasePenaltyINT;
-UINT32 iTotalPenaltyINT;
+THREADLOCAL UINT32 *aClausePenaltyINT;
+THREADLOCAL UINT32 iInitPenaltyINT;
+THREADLOCAL UINT32 iBasePenaltyINT;
+THREADLOCAL UINT32 iTotalPenaltyINT;
 
 
 
@@ -283,13 +296,13 @@ void UpdateMakeBreakPenaltyINT();
 void FlipMBPINTandFCLandVIF();
 void FlipMBPINTandFCLandVIFandW();
 
-UINT32 *aMakePenaltyINT;
-UINT32 *aBreakPenaltyINT;
+THREADLOCAL UINT32 *aMakePenaltyINT;
+THREADLOCAL UINT32 *aBreakPenaltyINT;
 
 
 /***** Trigger NullFlips *****/
 
-UINT32 iNumNullFlips;
+THREADLOCAL UINT32 iNumNullFlips;
 
 void InitNullFlips();
 void UpdateNullFlips();
@@ -297,7 +310,7 @@ void UpdateNullFlips();
 
 /***** Trigger LocalMins *****/
 
-UINT32 iNumLocalMins;
+THREADLOCAL UINT32 iNumLocalMins;
 
 void InitLocalMins();
 void UpdateLocalMins();
@@ -307,9 +320,9 @@ void UpdateLocalMins();
 
 void CreateLogDist();
 
-UINT32 *aLogDistValues;
-UINT32 iNumLogDistValues;
-UINT32 iLogDistStepsPerDecade;
+THREADLOCAL UINT32 *aLogDistValues;
+THREADLOCAL UINT32 iNumLogDistValues;
+THREADLOCAL UINT32 iLogDistStepsPerDecade;
 
 
 /***** Trigger BestFalse *****/
@@ -317,10 +330,10 @@ UINT32 iLogDistStepsPerDecade;
 void InitBestFalse();
 void UpdateBestFalse();
 
-UINT32 iBestNumFalse;
-UINT32 iBestStepNumFalse;
-FLOAT fBestSumFalseW;
-UINT32 iBestStepSumFalseW;
+THREADLOCAL UINT32 iBestNumFalse;
+THREADLOCAL UINT32 iBestStepNumFalse;
+THREADLOCAL FLOAT fBestSumFalseW;
+THREADLOCAL UINT32 iBestStepSumFalseW;
 
 
 /***** Trigger SaveBest *****/
@@ -328,23 +341,23 @@ UINT32 iBestStepSumFalseW;
 void CreateSaveBest();
 void UpdateSaveBest();
 
-VARSTATE vsBest;
+THREADLOCAL VARSTATE vsBest;
 
 
 /***** Trigger StartFalse *****/
 
 void UpdateStartFalse();
 
-UINT32 iStartNumFalse;
-FLOAT fStartSumFalseW;
+THREADLOCAL UINT32 iStartNumFalse;
+THREADLOCAL FLOAT fStartSumFalseW;
 
 
 /***** Trigger CalcImproveMean *****/
 
 void CalcImproveMean();
 
-FLOAT fImproveMean;
-FLOAT fImproveMeanW;
+THREADLOCAL FLOAT fImproveMean;
+THREADLOCAL FLOAT fImproveMeanW;
 
 
 /***** Trigger FirstLM *****/
@@ -353,18 +366,18 @@ void InitFirstLM();
 void UpdateFirstLM();
 void CalcFirstLM();
 
-UINT32 iFirstLM;
-UINT32 iFirstLMStep;
-FLOAT fFirstLMW;
-UINT32 iFirstLMStepW;
+THREADLOCAL UINT32 iFirstLM;
+THREADLOCAL UINT32 iFirstLMStep;
+THREADLOCAL FLOAT fFirstLMW;
+THREADLOCAL UINT32 iFirstLMStepW;
 
 
 /***** Trigger FirstLMRatio *****/
 
 void CalcFirstLMRatio();
 
-FLOAT fFirstLMRatio;
-FLOAT fFirstLMRatioW;
+THREADLOCAL FLOAT fFirstLMRatio;
+THREADLOCAL FLOAT fFirstLMRatioW;
 
 
 /***** Trigger TrajBestLM *****/
@@ -372,30 +385,30 @@ FLOAT fFirstLMRatioW;
 void UpdateTrajBestLM();
 void CalcTrajBestLM();
 
-UINT32 iTrajBestLMCount;
-FLOAT fTrajBestLMSum;
-FLOAT fTrajBestLMSum2;
-UINT32 iTrajBestLMCountW;
-FLOAT fTrajBestLMSumW;
-FLOAT fTrajBestLMSum2W;
+THREADLOCAL UINT32 iTrajBestLMCount;
+THREADLOCAL FLOAT fTrajBestLMSum;
+THREADLOCAL FLOAT fTrajBestLMSum2;
+THREADLOCAL UINT32 iTrajBestLMCountW;
+THREADLOCAL FLOAT fTrajBestLMSumW;
+THREADLOCAL FLOAT fTrajBestLMSum2W;
 
-FLOAT fTrajBestLMMean;
-FLOAT fTrajBestLMMeanW;
-FLOAT fTrajBestLMCV;
-FLOAT fTrajBestLMCVW;
+THREADLOCAL FLOAT fTrajBestLMMean;
+THREADLOCAL FLOAT fTrajBestLMMeanW;
+THREADLOCAL FLOAT fTrajBestLMCV;
+THREADLOCAL FLOAT fTrajBestLMCVW;
 
 /***** Trigger NoImprove *****/
 
 void CheckNoImprove();
 
-UINT32 iNoImprove;
+THREADLOCAL UINT32 iNoImprove;
 
 
 /***** Trigger StartSeed *****/
 
 void StartSeed();
 
-UINT32 iStartSeed;
+THREADLOCAL UINT32 iStartSeed;
 
 
 /***** Trigger CountRandom *****/
@@ -417,16 +430,16 @@ void CreateFlipCounts();
 void InitFlipCounts();
 void UpdateFlipCounts();
 
-UINT32 *aFlipCounts;
+THREADLOCAL UINT32 *aFlipCounts;
 
 
 /***** Trigger FlipCountStats *****/
 
 void FlipCountStats();
 
-FLOAT fFlipCountsMean;
-FLOAT fFlipCountsCV;
-FLOAT fFlipCountsStdDev;
+THREADLOCAL FLOAT fFlipCountsMean;
+THREADLOCAL FLOAT fFlipCountsCV;
+THREADLOCAL FLOAT fFlipCountsStdDev;
 
 
 /***** Trigger BiasCounts *****/
@@ -436,16 +449,16 @@ void PreInitBiasCounts();
 void UpdateBiasCounts();
 void FinalBiasCounts();
 
-UINT32 *aBiasTrueCounts;
-UINT32 *aBiasFalseCounts;
+THREADLOCAL UINT32 *aBiasTrueCounts;
+THREADLOCAL UINT32 *aBiasFalseCounts;
 
 
 /***** Trigger BiasStats *****/
 
 void BiasStats();
 
-FLOAT fMeanFinalBias;
-FLOAT fMeanMaxBias;
+THREADLOCAL FLOAT fMeanFinalBias;
+THREADLOCAL FLOAT fMeanMaxBias;
 
 
 /***** Trigger UnsatCounts *****/
@@ -454,16 +467,16 @@ void CreateUnsatCounts();
 void InitUnsatCounts();
 void UpdateUnsatCounts();
 
-UINT32 *aUnsatCounts;
+THREADLOCAL UINT32 *aUnsatCounts;
 
 
 /***** Trigger UnsatCountStats *****/
 
 void UnsatCountStats();
 
-FLOAT fUnsatCountsMean;
-FLOAT fUnsatCountsCV;
-FLOAT fUnsatCountsStdDev;
+THREADLOCAL FLOAT fUnsatCountsMean;
+THREADLOCAL FLOAT fUnsatCountsCV;
+THREADLOCAL FLOAT fUnsatCountsStdDev;
 
 
 /***** Trigger NumFalseCounts *****/
@@ -472,8 +485,8 @@ void CreateNumFalseCounts();
 void InitNumFalseCounts();
 void UpdateNumFalseCounts();
 
-UINT32 *aNumFalseCounts;
-UINT32 *aNumFalseCountsWindow;
+THREADLOCAL UINT32 *aNumFalseCounts;
+THREADLOCAL UINT32 *aNumFalseCountsWindow;
 
 
 /***** Trigger DistanceCounts *****/
@@ -482,8 +495,8 @@ void CreateDistanceCounts();
 void InitDistanceCounts();
 void UpdateDistanceCounts();
 
-UINT32 *aDistanceCounts;
-UINT32 *aDistanceCountsWindow;
+THREADLOCAL UINT32 *aDistanceCounts;
+THREADLOCAL UINT32 *aDistanceCountsWindow;
 
 
 /***** Trigger ClauseLast *****/
@@ -492,7 +505,7 @@ void CreateClauseLast();
 void InitClauseLast();
 void UpdateClauseLast();
 
-UINT32 *aClauseLast;
+THREADLOCAL UINT32 *aClauseLast;
 
 
 /***** Trigger SQGrid *****/
@@ -502,8 +515,8 @@ void InitSQGrid();
 void UpdateSQGrid();
 void FinishSQGrid();
 
-FLOAT *aSQGridW;
-UINT32 *aSQGrid;
+THREADLOCAL FLOAT *aSQGridW;
+THREADLOCAL UINT32 *aSQGrid;
 
 
 /***** Trigger PenaltyStats *****/
@@ -513,19 +526,19 @@ void InitPenaltyStats();
 void UpdatePenaltyStatsStep();
 void UpdatePenaltyStatsRun();
 
-FLOAT *aPenaltyStatsMean;
-FLOAT *aPenaltyStatsStddev;
-FLOAT *aPenaltyStatsCV;
+THREADLOCAL FLOAT *aPenaltyStatsMean;
+THREADLOCAL FLOAT *aPenaltyStatsStddev;
+THREADLOCAL FLOAT *aPenaltyStatsCV;
 
-FLOAT *aPenaltyStatsSum;
-FLOAT *aPenaltyStatsSum2;
+THREADLOCAL FLOAT *aPenaltyStatsSum;
+THREADLOCAL FLOAT *aPenaltyStatsSum2;
 
-FLOAT *aPenaltyStatsMeanSum;
-FLOAT *aPenaltyStatsMeanSum2;
-FLOAT *aPenaltyStatsStddevSum;
-FLOAT *aPenaltyStatsStddevSum2;
-FLOAT *aPenaltyStatsCVSum;
-FLOAT *aPenaltyStatsCVSum2;
+THREADLOCAL FLOAT *aPenaltyStatsMeanSum;
+THREADLOCAL FLOAT *aPenaltyStatsMeanSum2;
+THREADLOCAL FLOAT *aPenaltyStatsStddevSum;
+THREADLOCAL FLOAT *aPenaltyStatsStddevSum2;
+THREADLOCAL FLOAT *aPenaltyStatsCVSum;
+THREADLOCAL FLOAT *aPenaltyStatsCVSum2;
 
 
 /***** Trigger VarFlipHistory *****/
@@ -533,8 +546,8 @@ FLOAT *aPenaltyStatsCVSum2;
 void CreateVarFlipHistory();
 void UpdateVarFlipHistory();
 
-UINT32 *aVarFlipHistory;
-UINT32 iVarFlipHistoryLen;
+THREADLOCAL UINT32 *aVarFlipHistory;
+THREADLOCAL UINT32 iVarFlipHistoryLen;
 
 
 /***** Trigger MobilityWindow *****/
@@ -543,10 +556,10 @@ void CreateMobilityWindow();
 void InitMobilityWindow();
 void UpdateMobilityWindow();
 
-UINT32 *aMobilityWindowVarChange;
-UINT32 *aMobilityWindow;
-FLOAT *aMobilityWindowSum;
-FLOAT *aMobilityWindowSum2;
+THREADLOCAL UINT32 *aMobilityWindowVarChange;
+THREADLOCAL UINT32 *aMobilityWindow;
+THREADLOCAL FLOAT *aMobilityWindowSum;
+THREADLOCAL FLOAT *aMobilityWindowSum2;
 
 
 /***** Trigger MobilityFixedFrequencies *****/
@@ -555,7 +568,7 @@ void CreateMobilityFixedFrequencies();
 void InitMobilityFixedFrequencies();
 void UpdateMobilityFixedFrequencies();
 
-UINT32 *aMobilityFixedFrequencies;
+THREADLOCAL UINT32 *aMobilityFixedFrequencies;
 
 
 /***** Trigger AutoCorr *****/
@@ -565,15 +578,15 @@ void InitAutoCorr();
 void UpdateAutoCorr();
 void CalcAutoCorr();
 
-UINT32 iAutoCorrMaxLen;
-FLOAT fAutoCorrCutoff;
-UINT32 iAutoCorrLen;
-FLOAT *aAutoCorrValues;
-FLOAT *aAutoCorrStartBuffer;
-FLOAT *aAutoCorrEndCircBuffer;
-FLOAT fAutoCorrSum;
-FLOAT fAutoCorrSum2;
-FLOAT *aAutoCorrCrossSum;
+THREADLOCAL UINT32 iAutoCorrMaxLen;
+THREADLOCAL FLOAT fAutoCorrCutoff;
+THREADLOCAL UINT32 iAutoCorrLen;
+THREADLOCAL FLOAT *aAutoCorrValues;
+THREADLOCAL FLOAT *aAutoCorrStartBuffer;
+THREADLOCAL FLOAT *aAutoCorrEndCircBuffer;
+THREADLOCAL FLOAT fAutoCorrSum;
+THREADLOCAL FLOAT fAutoCorrSum2;
+THREADLOCAL FLOAT *aAutoCorrCrossSum;
 
 /***** Trigger AutoCorrOne *****/
 
@@ -581,13 +594,13 @@ void InitAutoCorrOne();
 void UpdateAutoCorrOne();
 void CalcAutoCorrOne();
 
-FLOAT fAutoCorrOneVal;
-FLOAT fAutoCorrOneEst;
-FLOAT fAutoCorrOneStart;
-FLOAT fAutoCorrOneLast;
-FLOAT fAutoCorrOneSum;
-FLOAT fAutoCorrOneSum2;
-FLOAT fAutoCorrOneCrossSum;
+THREADLOCAL FLOAT fAutoCorrOneVal;
+THREADLOCAL FLOAT fAutoCorrOneEst;
+THREADLOCAL FLOAT fAutoCorrOneStart;
+THREADLOCAL FLOAT fAutoCorrOneLast;
+THREADLOCAL FLOAT fAutoCorrOneSum;
+THREADLOCAL FLOAT fAutoCorrOneSum2;
+THREADLOCAL FLOAT fAutoCorrOneCrossSum;
 
 
 /***** Trigger BranchFactor *****/
@@ -595,8 +608,8 @@ FLOAT fAutoCorrOneCrossSum;
 void BranchFactor();
 void BranchFactorW();
 
-FLOAT fBranchFactor;
-FLOAT fBranchFactorW;
+THREADLOCAL FLOAT fBranchFactor;
+THREADLOCAL FLOAT fBranchFactorW;
 
 
 /****** Trigger StepsUpDownSide *****/
@@ -604,25 +617,25 @@ FLOAT fBranchFactorW;
 void InitStepsUpDownSide();
 void UpdateStepsUpDownSide();
 
-UINT32 iNumUpSteps;
-UINT32 iNumDownSteps;
-UINT32 iNumSideSteps;
-UINT32 iNumUpStepsW;
-UINT32 iNumDownStepsW;
-UINT32 iNumSideStepsW;
+THREADLOCAL UINT32 iNumUpSteps;
+THREADLOCAL UINT32 iNumDownSteps;
+THREADLOCAL UINT32 iNumSideSteps;
+THREADLOCAL UINT32 iNumUpStepsW;
+THREADLOCAL UINT32 iNumDownStepsW;
+THREADLOCAL UINT32 iNumSideStepsW;
 
 /****** Trigger NumRestarts *****/
 
 void NumRestarts();
 
-UINT32 iNumRestarts;
+THREADLOCAL UINT32 iNumRestarts;
 
 /***** Trigger LoadKnownSolutions *****/
 
 void LoadKnownSolutions();
 
-VARSTATELIST vslKnownSoln;
-BOOL bKnownSolutions;
+THREADLOCAL VARSTATELIST vslKnownSoln;
+THREADLOCAL BOOL bKnownSolutions;
 
 
 /***** Trigger SolutionDistance *****/
@@ -630,8 +643,8 @@ BOOL bKnownSolutions;
 void CreateSolutionDistance();
 void UpdateSolutionDistance();
 
-VARSTATE vsSolutionDistance;
-UINT32 iSolutionDistance;
+THREADLOCAL VARSTATE vsSolutionDistance;
+THREADLOCAL UINT32 iSolutionDistance;
 
 
 /***** Trigger FDCRun *****/
@@ -641,14 +654,14 @@ void InitFDCRun();
 void UpdateFDCRun();
 void CalcFDCRun();
 
-FLOAT fFDCRun;
+THREADLOCAL FLOAT fFDCRun;
 
-FLOAT fFDCRunHeightDistanceSum;
-FLOAT fFDCRunHeightSum;
-FLOAT fFDCRunHeightSum2;
-FLOAT fFDCRunDistanceSum;
-FLOAT fFDCRunDistanceSum2;
-UINT32 iFDCRunCount;
+THREADLOCAL FLOAT fFDCRunHeightDistanceSum;
+THREADLOCAL FLOAT fFDCRunHeightSum;
+THREADLOCAL FLOAT fFDCRunHeightSum2;
+THREADLOCAL FLOAT fFDCRunDistanceSum;
+THREADLOCAL FLOAT fFDCRunDistanceSum2;
+THREADLOCAL UINT32 iFDCRunCount;
 
 
 
@@ -675,18 +688,18 @@ void CheckWeighted();
 void CreateUniqueSolutions();
 void UpdateUniqueSolutions();
 
-VARSTATELIST vslUnique;
-VARSTATE vsCheckUnique;
-UINT32 iNumUniqueSolutions;
-UINT32 iLastUnique;
+THREADLOCAL VARSTATELIST vslUnique;
+THREADLOCAL VARSTATE vsCheckUnique;
+THREADLOCAL UINT32 iNumUniqueSolutions;
+THREADLOCAL UINT32 iLastUnique;
 
 
 /***** Trigger VarsShareClauses *****/
 
-UINT32 *aNumVarsShareClause;
-UINT32 *aVarsShareClauseData;
-UINT32 **pVarsShareClause;
-UINT32 iNumShareClauses;
+THREADLOCAL UINT32 *aNumVarsShareClause;
+THREADLOCAL UINT32 *aVarsShareClauseData;
+THREADLOCAL UINT32 **pVarsShareClause;
+THREADLOCAL UINT32 iNumShareClauses;
 
 void CreateVarsShareClauses();
 
@@ -716,6 +729,7 @@ void AddDataTriggers() {
   
   CreateContainerTrigger("DefaultProcedures","ReadCNF,LitOccurence,CandidateList,InitVarsFromFile,DefaultStateInfo,DefaultInitVars,DefaultFlip,CheckTermination");
   CreateContainerTrigger("DefaultProceduresUCT","ReadCNF,LitOccurence,CandidateList,InitVarsFromFile,DefaultStateInfo,DefaultInitVarsUCT,DefaultFlip,CheckTermination");
+  CreateContainerTrigger("DefaultProceduresUCTW","ReadCNF,LitOccurence,CandidateList,InitVarsFromFile,DefaultStateInfo,DefaultInitVarsUCT,DefaultFlipW,CheckTermination");
   CreateContainerTrigger("DefaultProceduresW","ReadCNF,LitOccurence,CandidateList,InitVarsFromFile,DefaultStateInfo,DefaultInitVars,DefaultFlipW,CheckTermination");
 
   CreateTrigger("CreateFalseClauseList",CreateStateInfo,CreateFalseClauseList,"","");
@@ -743,12 +757,22 @@ void AddDataTriggers() {
   CreateContainerTrigger("MakeBreak","CreateMakeBreak,InitMakeBreak,UpdateMakeBreak");
   CreateTrigger("Flip+MakeBreak",FlipCandidate,FlipMakeBreak,"MakeBreak","DefaultFlip,UpdateMakeBreak");
 
+  CreateTrigger("InitMakeBreakUCT",InitStateInfo,InitMakeBreakUCT,"InitDefaultStateInfo","");
+  CreateTrigger("UpdateMakeBreakUCT",UpdateStateInfo,UpdateMakeBreakUCT,"","");
+  CreateContainerTrigger("MakeBreakUCT","CreateMakeBreak,InitMakeBreakUCT,UpdateMakeBreakUCT");
+  CreateTrigger("Flip+MakeBreakUCT",FlipCandidate,FlipMakeBreakUCT,"MakeBreakUCT,FalseClauseList","DefaultFlip,UpdateMakeBreakUCT,UpdateFalseClauseList");
+
   CreateTrigger("CreateMakeBreakW",CreateStateInfo,CreateMakeBreakW,"","");
   CreateTrigger("InitMakeBreakW",InitStateInfo,InitMakeBreakW,"InitDefaultStateInfo","");
   CreateTrigger("UpdateMakeBreakW",UpdateStateInfo,UpdateMakeBreakW,"","");
   CreateContainerTrigger("MakeBreakW","CreateMakeBreakW,InitMakeBreakW,UpdateMakeBreakW");
   CreateTrigger("Flip+MakeBreakW",FlipCandidate,FlipMakeBreakW,"MakeBreakW","DefaultFlipW,UpdateMakeBreakW");
 
+  CreateTrigger("InitMakeBreakUCTW",InitStateInfo,InitMakeBreakUCTW,"InitDefaultStateInfo","");
+  CreateTrigger("UpdateMakeBreakUCTW",UpdateStateInfo,UpdateMakeBreakUCTW,"","");
+  CreateContainerTrigger("MakeBreakUCTW","CreateMakeBreakW,InitMakeBreakUCTW,UpdateMakeBreakUCTW");
+  CreateTrigger("Flip+MakeBreakUCTW",FlipCandidate,FlipMakeBreakUCTW,"MakeBreakUCTW,FalseClauseList","DefaultFlipW,UpdateMakeBreakUCTW,UpdateFalseClauseList");
+
   CreateTrigger("CreateVarInFalse",CreateStateInfo,CreateVarInFalse,"CreateMakeBreak","");
   CreateTrigger("InitVarInFalse",InitStateInfo,InitVarInFalse,"InitMakeBreak","");
   CreateTrigger("UpdateVarInFalse",UpdateStateInfo,UpdateVarInFalse,"","UpdateMakeBreak");
@@ -960,6 +984,8 @@ void AddDataTriggers() {
   CreateTrigger("CloseFileRandom",FinalReports,CloseFileRandom,"","");
   CreateContainerTrigger("FileRandom","CreateFileRandom,CloseFileRandom");
 
+  CreateTrigger("LegacyRandom",PostParameters,SetupLegacyRandom,"","");
+
   CreateTrigger("FileAbort",PostRun,FileAbort,"","");
 
   CreateTrigger("DynamicParms",PostRead,DynamicParms,"","");
@@ -977,7 +1003,7 @@ void AddDataTriggers() {
 }
 
 
-char sLine[MAXCNFLINELEN];
+THREADLOCAL char sLine[MAXCNFLINELEN];
 
 void ReadCNF() {
   UINT32 j;
@@ -994,6 +1020,10 @@ void ReadCNF() {
 
   FILE *filInput;
 
+  if (bInstanceShared) {
+    return;
+  }
+
   bIsWCNF = FALSE;
 
   iNumClauses = 0;
@@ -1014,7 +1044,8 @@ void ReadCNF() {
     if (sLine[0] =='p') {
       if (bWeighted) {
         if (bIsWCNF) {
-          sscanf(sLine,"p wcnf %lu %lu",&iNumVars,&iNumClauses);
+          fHardWeight = FLOATZERO;
+          sscanf(sLine,"p wcnf %lu %lu %lf",&iNumVars,&iNumClauses,&fHardWeight);
         } else {
           ReportPrint(pRepErr,"Warning! reading .cnf file and setting all weights = 1\n");
           sscanf(sLine,"p cnf %lu %lu",&iNumVars,&iNumClauses);
@@ -1046,10 +1077,10 @@ void ReadCNF() {
     iVARSTATELen--;
   }
   
-  aClauseLen = AllocateRAM(iNumClauses * sizeof(UINT32));
-  pClauseLits = AllocateRAM(iNumClauses * sizeof(LITTYPE *));
+  aClauseLen = AllocateSharedRAM(iNumClauses * sizeof(UINT32));
+  pClauseLits = AllocateSharedRAM(iNumClauses * sizeof(LITTYPE *));
   if (bWeighted) {
-    aClauseWeight = AllocateRAM(iNumClauses * sizeof(FLOAT));
+    aClauseWeight = AllocateSharedRAM(iNumClauses * sizeof(FLOAT));
   }
   
   pLastLit = pNextLit = pData = 0;
@@ -1099,7 +1130,7 @@ void ReadCNF() {
       if (l) {
         
         if (pNextLit >= pLastLit) {
-          pData = AllocateRAM(LITSPERCHUNK * sizeof(LITTYPE));
+          pData = AllocateSharedRAM(LITSPERCHUNK * sizeof(LITTYPE));
           pNextLit = pData;
           pLastLit = pData + LITSPERCHUNK;
           for (k=0;k<aClauseLen[j];k++) {
@@ -1128,7 +1159,7 @@ void ReadCNF() {
     }
   }
 
-  AdjustLastRAM((pNextLit - pData) * sizeof(LITTYPE));
+  AdjustLastSharedRAM((pNextLit - pData) * sizeof(LITTYPE));
 
   CloseSingleFile(filInput);  
 
@@ -1140,9 +1171,13 @@ void CreateLitOccurence() {
   LITTYPE *pLit;
   LITTYPE *pCur;
 
-  aNumLitOcc = AllocateRAM((iNumVars+1)*2*sizeof(UINT32));
-  pLitClause = AllocateRAM((iNumVars+1)*2*sizeof(UINT32 *));
-  aLitOccData = AllocateRAM(iNumLits*sizeof(UINT32));
+  if (bInstanceShared) {
+    return;
+  }
+
+  aNumLitOcc = AllocateSharedRAM((iNumVars+1)*2*sizeof(UINT32));
+  pLitClause = AllocateSharedRAM((iNumVars+1)*2*sizeof(UINT32 *));
+  aLitOccData = AllocateSharedRAM(iNumLits*sizeof(UINT32));
 
   memset(aNumLitOcc,0,(iNumVars+1)*2*sizeof(UINT32));
   
@@ -1178,7 +1213,7 @@ void CreateCandidateList() {
   iMaxCandidates = iNumClauses;
 }
 
-char sInitLine[MAXPARMLINELEN];
+THREADLOCAL char sInitLine[MAXPARMLINELEN];
 
 void InitVarsFromFile() {
   SINT32 iLit;
@@ -1371,7 +1406,7 @@ void DefaultInitVarsUCT() {
 
   for (j=1;j<=iNumVars;j++) {
     /* Don't consider immutable variables! */
-    if (!varMutable[j]) continue;
+    if (!IsMutable(j)) continue;
     aVarValue[j] = bestSoln[j];
     //aVarValue[j] = RandomInt(2);
   }
@@ -2177,6 +2212,190 @@ void FlipMakeBreak() {
   }
 }
 
+/* The UCT variants leave the preSat clauses out of the counts. A mutable variable can't
+   make or break a preSat clause, and preSat is fixed for the length of an SLS run, so
+   the counts of the mutable variables are the same as with MakeBreak, for less work */
+
+void InitMakeBreakUCT() {
+  UINT32 j;
+  UINT32 k;
+  UINT32 iVar;
+  LITTYPE *pLit;
+  
+  memset(aMakeCount,0,(iNumVars+1)*sizeof(UINT32));
+  memset(aBreakCount,0,(iNumVars+1)*sizeof(UINT32));
+  memset(aCritSat,0,iNumClauses*sizeof(UINT32));
+  
+  for (j=0;j<iNumClauses;j++) {
+    if (IsPreSat(j)) {
+      continue;
+    }
+    if (aNumTrueLit[j]==0) {
+      for (k=0;k<aClauseLen[j];k++) {
+        aMakeCount[GetVar(j,k)]++;
+      }
+    } else if (aNumTrueLit[j]==1) {
+      pLit = pClauseLits[j];
+      for (k=0;k<aClauseLen[j];k++) {
+        if IsLitTrue(*pLit) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCount[iVar]++;
+          aCritSat[j] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+}
+
+
+void UpdateMakeBreakUCT() {
+
+  UINT32 j;
+  UINT32 k;
+  UINT32 *pClause;
+  UINT32 iVar;
+  LITTYPE litWasTrue;
+  LITTYPE litWasFalse;
+  LITTYPE *pLit;
+
+  if (iFlipCandidate == 0) {
+    return;
+  }
+
+  litWasTrue = GetFalseLit(iFlipCandidate);
+  litWasFalse = GetTrueLit(iFlipCandidate);
+
+  pClause = pLitClause[litWasTrue];
+  for (j=0;j<aNumLitOcc[litWasTrue];j++,pClause++) {
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==0) { 
+      aBreakCount[iFlipCandidate]--;
+      
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        aMakeCount[GetVarFromLit(*pLit)]++;
+        pLit++;
+      }
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        if (IsLitTrue(*pLit)) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCount[iVar]++;
+          aCritSat[*pClause] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+
+  pClause = pLitClause[litWasFalse];
+  for (j=0;j<aNumLitOcc[litWasFalse];j++,pClause++) {
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        iVar = GetVarFromLit(*pLit);
+        aMakeCount[iVar]--;
+        pLit++;
+      }
+      aBreakCount[iFlipCandidate]++;
+      aCritSat[*pClause] = iFlipCandidate;
+    }
+    if (aNumTrueLit[*pClause]==2) {
+      aBreakCount[aCritSat[*pClause]]--;
+    }
+  }
+}
+
+
+void FlipMakeBreakUCT() {
+
+  UINT32 j;
+  UINT32 k;
+  UINT32 *pClause;
+  UINT32 iVar;
+  LITTYPE litWasTrue;
+  LITTYPE litWasFalse;
+  LITTYPE *pLit;
+
+  if (iFlipCandidate == 0) {
+    return;
+  }
+
+  litWasTrue = GetTrueLit(iFlipCandidate);
+  litWasFalse = GetFalseLit(iFlipCandidate);
+
+  aVarValue[iFlipCandidate] = 1 - aVarValue[iFlipCandidate];
+
+  // a preSat clause can never change between true and false, so it stays out of the false list
+  pClause = pLitClause[litWasTrue];
+  for (j=0;j<aNumLitOcc[litWasTrue];j++,pClause++) {
+    aNumTrueLit[*pClause]--;
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==0) { 
+      
+      aFalseList[iNumFalse] = *pClause;
+      aFalseListPos[*pClause] = iNumFalse++;
+
+      aBreakCount[iFlipCandidate]--;
+      
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        aMakeCount[GetVarFromLit(*pLit)]++;
+        pLit++;
+      }
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        if (IsLitTrue(*pLit)) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCount[iVar]++;
+          aCritSat[*pClause] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+
+  pClause = pLitClause[litWasFalse];
+  for (j=0;j<aNumLitOcc[litWasFalse];j++,pClause++) {
+    aNumTrueLit[*pClause]++;
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==1) {
+
+      aFalseList[aFalseListPos[*pClause]] = aFalseList[--iNumFalse];
+      aFalseListPos[aFalseList[iNumFalse]] = aFalseListPos[*pClause];
+
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        iVar = GetVarFromLit(*pLit);
+        aMakeCount[iVar]--;
+        pLit++;
+      }
+      aBreakCount[iFlipCandidate]++;
+      aCritSat[*pClause] = iFlipCandidate;
+    }
+    if (aNumTrueLit[*pClause]==2) {
+      aBreakCount[aCritSat[*pClause]]--;
+    }
+  }
+}
+
 void CreateMakeBreakW() {
   aBreakCountW = AllocateRAM((iNumVars+1)*sizeof(FLOAT));
   aMakeCountW = AllocateRAM((iNumVars+1)*sizeof(FLOAT));
@@ -2357,6 +2576,194 @@ void FlipMakeBreakW() {
   }
 }
 
+/* The weighted UCT variants leave the preSat clauses out of the sums, as the unweighted ones do */
+
+void InitMakeBreakUCTW() {
+  UINT32 j;
+  UINT32 k;
+  UINT32 iVar;
+  LITTYPE *pLit;
+  
+  for (j=1;j<=iNumVars;j++) {
+    aMakeCountW[j] = FLOATZERO;
+    aBreakCountW[j] = FLOATZERO;
+  }
+  memset(aCritSat,0,iNumClauses*sizeof(UINT32));
+  
+  for (j=0;j<iNumClauses;j++) {
+    if (IsPreSat(j)) {
+      continue;
+    }
+    if (aNumTrueLit[j]==0) {
+      for (k=0;k<aClauseLen[j];k++) {
+        aMakeCountW[GetVar(j,k)] += aClauseWeight[j];
+      }
+    } else if (aNumTrueLit[j]==1) {
+      pLit = pClauseLits[j];
+      for (k=0;k<aClauseLen[j];k++) {
+        if IsLitTrue(*pLit) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCountW[iVar] += aClauseWeight[j];
+          aCritSat[j] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+}
+
+
+void UpdateMakeBreakUCTW() {
+
+  UINT32 j;
+  UINT32 k;
+  UINT32 *pClause;
+  UINT32 iVar;
+  LITTYPE litWasTrue;
+  LITTYPE litWasFalse;
+  LITTYPE *pLit;
+
+  if (iFlipCandidate == 0) {
+    return;
+  }
+
+  litWasTrue = GetFalseLit(iFlipCandidate);
+  litWasFalse = GetTrueLit(iFlipCandidate);
+
+  pClause = pLitClause[litWasTrue];
+  for (j=0;j<aNumLitOcc[litWasTrue];j++,pClause++) {
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==0) { 
+      aBreakCountW[iFlipCandidate] -= aClauseWeight[*pClause];
+      
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        aMakeCountW[GetVarFromLit(*pLit)] += aClauseWeight[*pClause];
+        pLit++;
+      }
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        if (IsLitTrue(*pLit)) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCountW[iVar] += aClauseWeight[*pClause];
+          aCritSat[*pClause] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+
+  pClause = pLitClause[litWasFalse];
+  for (j=0;j<aNumLitOcc[litWasFalse];j++,pClause++) {
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        iVar = GetVarFromLit(*pLit);
+        aMakeCountW[iVar] -= aClauseWeight[*pClause];
+        pLit++;
+      }
+      aBreakCountW[iFlipCandidate] += aClauseWeight[*pClause];
+      aCritSat[*pClause] = iFlipCandidate;
+    }
+    if (aNumTrueLit[*pClause]==2) {
+      aBreakCountW[aCritSat[*pClause]] -= aClauseWeight[*pClause];
+    }
+  }
+}
+
+
+void FlipMakeBreakUCTW() {
+
+  UINT32 j;
+  UINT32 k;
+  UINT32 *pClause;
+  UINT32 iVar;
+  LITTYPE litWasTrue;
+  LITTYPE litWasFalse;
+  LITTYPE *pLit;
+
+  if (iFlipCandidate == 0) {
+    return;
+  }
+
+  litWasTrue = GetTrueLit(iFlipCandidate);
+  litWasFalse = GetFalseLit(iFlipCandidate);
+
+  aVarValue[iFlipCandidate] = 1 - aVarValue[iFlipCandidate];
+
+  // a preSat clause can never change between true and false, so it stays out of the false list
+  pClause = pLitClause[litWasTrue];
+  for (j=0;j<aNumLitOcc[litWasTrue];j++,pClause++) {
+    aNumTrueLit[*pClause]--;
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==0) { 
+      
+      aFalseList[iNumFalse] = *pClause;
+      aFalseListPos[*pClause] = iNumFalse++;
+
+      fSumFalseW += aClauseWeight[*pClause];
+
+      aBreakCountW[iFlipCandidate] -= aClauseWeight[*pClause];
+      
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        aMakeCountW[GetVarFromLit(*pLit)] += aClauseWeight[*pClause];
+        pLit++;
+      }
+    }
+    if (aNumTrueLit[*pClause]==1) {
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        if (IsLitTrue(*pLit)) {
+          iVar = GetVarFromLit(*pLit);
+          aBreakCountW[iVar] += aClauseWeight[*pClause];
+          aCritSat[*pClause] = iVar;
+          break;
+        }
+        pLit++;
+      }
+    }
+  }
+
+  pClause = pLitClause[litWasFalse];
+  for (j=0;j<aNumLitOcc[litWasFalse];j++,pClause++) {
+    aNumTrueLit[*pClause]++;
+    if (IsPreSat(*pClause)) {
+      continue;
+    }
+    if (aNumTrueLit[*pClause]==1) {
+
+      aFalseList[aFalseListPos[*pClause]] = aFalseList[--iNumFalse];
+      aFalseListPos[aFalseList[iNumFalse]] = aFalseListPos[*pClause];
+
+      fSumFalseW -= aClauseWeight[*pClause];
+
+      pLit = pClauseLits[*pClause];
+      for (k=0;k<aClauseLen[*pClause];k++) {
+        iVar = GetVarFromLit(*pLit);
+        aMakeCountW[iVar] -= aClauseWeight[*pClause];
+        pLit++;
+      }
+      aBreakCountW[iFlipCandidate] += aClauseWeight[*pClause];
+      aCritSat[*pClause] = iFlipCandidate;
+    }
+    if (aNumTrueLit[*pClause]==2) {
+      aBreakCountW[aCritSat[*pClause]] -= aClauseWeight[*pClause];
+    }
+  }
+}
+
 void CreateVarInFalse() {
   aVarInFalseList = AllocateRAM((iNumVars+1)* sizeof(UINT32));
   aVarInFalseListPos = AllocateRAM((iNumVars+1)* sizeof(UINT32));
@@ -4065,17 +4472,17 @@ void CalcFirstLMRatio() {
   }
 }
 
-UINT32 iTrajBestLMCount;
-FLOAT fTrajBestLMSum;
-FLOAT fTrajBestLMSum2;
-UINT32 iTrajBestLMCountW;
-FLOAT fTrajBestLMSumW;
-FLOAT fTrajBestLMSum2W;
+THREADLOCAL UINT32 iTrajBestLMCount;
+THREADLOCAL FLOAT fTrajBestLMSum;
+THREADLOCAL FLOAT fTrajBestLMSum2;
+THREADLOCAL UINT32 iTrajBestLMCountW;
+THREADLOCAL FLOAT fTrajBestLMSumW;
+THREADLOCAL FLOAT fTrajBestLMSum2W;
 
-FLOAT fTrajBestLMMean;
-FLOAT fTrajBestLMMeanW;
-FLOAT fTrajBestLMCV;
-FLOAT fTrajBestLMCVW;
+THREADLOCAL FLOAT fTrajBestLMMean;
+THREADLOCAL FLOAT fTrajBestLMMeanW;
+THREADLOCAL FLOAT fTrajBestLMCV;
+THREADLOCAL FLOAT fTrajBestLMCVW;
 
 void UpdateTrajBestLM() {
 
@@ -4407,7 +4814,7 @@ void UpdateClauseLast() {
   }
 }
 
-UINT32 iNextSQGridCol;
+THREADLOCAL UINT32 iNextSQGridCol;
 
 void CreateSQGrid() {
   if (bWeighted) {
@@ -4826,8 +5233,8 @@ void BranchFactorW() {
 }
 
 
-UINT32 iSUDSLastNumFalse;
-FLOAT fSUDSfLastSumFalseW;
+THREADLOCAL UINT32 iSUDSLastNumFalse;
+THREADLOCAL FLOAT fSUDSfLastSumFalseW;
 
 void InitStepsUpDownSide() {
   iNumUpSteps = 0;
@@ -34,6 +34,13 @@ void AddDataTriggers();
 
     aClauseWeight         (if weighted algorithm) weight of clause[j]
     fTotalWeight          sum of all clause weights
+    fHardWeight           (if weighted algorithm) top weight of a partial .wcnf file, the
+                          weight of its hard clauses, 0 if the file gives none
+
+    bInstanceShared       set once the instance is loaded: the instance data is then
+                          shared by every thread, and ReadCNF and LitOccurence leave it as is.
+                          It is allocated with AllocateSharedRAM, so it outlives the heaps
+                          of the thread that read it, and FreeSharedRAM releases it
 */
 
 extern UINT32 iNumVars;
@@ -45,9 +52,12 @@ extern LITTYPE **pClauseLits;
 
 extern FLOAT *aClauseWeight;
 extern FLOAT fTotalWeight;
+extern FLOAT fHardWeight;
 
 extern UINT32 iVARSTATELen;
 
+extern BOOL bInstanceShared;
+
 
 /***** Trigger LitOccurence *****/
 /* 
@@ -67,9 +77,9 @@ extern UINT32 **pLitClause;
     iMaxCandidates        maximum size of the array
 */
 
-extern UINT32 *aCandidateList;
-extern UINT32 iNumCandidates;
-extern UINT32 iMaxCandidates;
+extern THREADLOCAL UINT32 *aCandidateList;
+extern THREADLOCAL UINT32 iNumCandidates;
+extern THREADLOCAL UINT32 iMaxCandidates;
 
 
 /***** Trigger InitVarsFromFile *****/
@@ -81,9 +91,9 @@ extern UINT32 iMaxCandidates;
     bVarInitGreedy        if true, then greedily init vars that have a biased # of pos/neg literals
 */
   
-extern UINT32 *aVarInit;
-extern UINT32 iInitVarFlip;
-extern BOOL bVarInitGreedy;
+extern THREADLOCAL UINT32 *aVarInit;
+extern THREADLOCAL UINT32 iInitVarFlip;
+extern THREADLOCAL BOOL bVarInitGreedy;
 
 
 /***** Trigger DefaultStateInfo *****/
@@ -94,10 +104,10 @@ extern BOOL bVarInitGreedy;
     aVarValue[j]          current value of variable[j] (0,1 => False,True)
 */
 
-extern UINT32 *aNumTrueLit;
-extern UINT32 *aVarValue;
-extern UINT32 iNumFalse;
-extern FLOAT fSumFalseW;
+extern THREADLOCAL UINT32 *aNumTrueLit;
+extern THREADLOCAL UINT32 *aVarValue;
+extern THREADLOCAL UINT32 iNumFalse;
+extern THREADLOCAL FLOAT fSumFalseW;
 
 
 /***** Trigger DefaultFlip[W] *****/
@@ -114,9 +124,9 @@ extern FLOAT fSumFalseW;
     iNumFalseList         # entries in aFalseList (the same as iNumFalse, but updated separately)
 */
 
-extern UINT32 *aFalseList;
-extern UINT32 *aFalseListPos;
-extern UINT32 iNumFalseList;
+extern THREADLOCAL UINT32 *aFalseList;
+extern THREADLOCAL UINT32 *aFalseListPos;
+extern THREADLOCAL UINT32 iNumFalseList;
 
 
 /***** Trigger VarScore[W] *****/
@@ -126,12 +136,16 @@ extern UINT32 iNumFalseList;
     aVarScoreW[j]         weighted score for variable[j]... Change in sum of false clause weights if variable[j] is flipped
 */
 
-extern SINT32 *aVarScore;
-extern FLOAT *aVarScoreW;
+extern THREADLOCAL SINT32 *aVarScore;
+extern THREADLOCAL FLOAT *aVarScoreW;
 
 
 /***** Trigger MakeBreak[W] *****/
 /***** Trigger Flip+MakeBreak[W] *****/
+/***** Trigger MakeBreakUCT *****/
+/***** Trigger Flip+MakeBreakUCT *****/
+/***** Trigger MakeBreakUCTW *****/
+/***** Trigger Flip+MakeBreakUCTW *****/
 /*
     aMakeCount[k]         # of clauses that flipping variable[j] will 'make'
     aBreakCount[k]        # of clauses that flipping variable[j] will 'break'
@@ -139,13 +153,15 @@ extern FLOAT *aVarScoreW;
     aMakeCountW[k]        (same as aMakeCount, but as a sum of clause weights)
     aBreakCountW[k]       (same as aBreakCount, but as a sum of clause weights)
 
+    the UCT variants leave preSat clauses out of the counts, the sums and aCritSat
+
 */
 
-extern UINT32 *aBreakCount;
-extern UINT32 *aMakeCount;
-extern UINT32 *aCritSat;
-extern FLOAT *aBreakCountW;
-extern FLOAT *aMakeCountW;
+extern THREADLOCAL UINT32 *aBreakCount;
+extern THREADLOCAL UINT32 *aMakeCount;
+extern THREADLOCAL UINT32 *aCritSat;
+extern THREADLOCAL FLOAT *aBreakCountW;
+extern THREADLOCAL FLOAT *aMakeCountW;
 
 
 /***** Trigger VarInFalse *****/
@@ -156,9 +172,9 @@ extern FLOAT *aMakeCountW;
     iNumVarsInFalseList   # variables that appear in false clauses 
 */
 
-extern UINT32 iNumVarsInFalseList;
-extern UINT32 *aVarInFalseList;
-extern UINT32 *aVarInFalseListPos;
+extern THREADLOCAL UINT32 iNumVarsInFalseList;
+extern THREADLOCAL UINT32 *aVarInFalseList;
+extern THREADLOCAL UINT32 *aVarInFalseListPos;
 
 
 /***** Trigger VarLastChange *****/
@@ -168,8 +184,8 @@ extern UINT32 *aVarInFalseListPos;
 */
 
 void UpdateVarLastChange();
-extern UINT32 *aVarLastChange;
-extern UINT32 iVarLastChangeReset;
+extern THREADLOCAL UINT32 *aVarLastChange;
+extern THREADLOCAL UINT32 iVarLastChangeReset;
 
 
 /***** Trigger TrackChanges *****/
@@ -180,15 +196,15 @@ extern UINT32 iVarLastChangeReset;
     aChangeLastStep[j]    the step of the last change for variable[j]
 */
 
-extern UINT32 iNumChanges;
-extern UINT32 *aChangeList;
-extern SINT32 *aChangeOldScore;
-extern UINT32 *aChangeLastStep;
+extern THREADLOCAL UINT32 iNumChanges;
+extern THREADLOCAL UINT32 *aChangeList;
+extern THREADLOCAL SINT32 *aChangeOldScore;
+extern THREADLOCAL UINT32 *aChangeLastStep;
 
-extern UINT32 iNumChangesW;
-extern UINT32 *aChangeListW;
-extern FLOAT *aChangeOldScoreW;
-extern UINT32 *aChangeLastStepW;
+extern THREADLOCAL UINT32 iNumChangesW;
+extern THREADLOCAL UINT32 *aChangeListW;
+extern THREADLOCAL FLOAT *aChangeOldScoreW;
+extern THREADLOCAL UINT32 *aChangeLastStepW;
 
 #define UpdateChange(var) {if(aChangeLastStep[var]!=iStep) {aChangeOldScore[var] = aVarScore[var]; aChangeLastStep[var]=iStep; aChangeList[iNumChanges++]=var;}}
 
@@ -199,11 +215,11 @@ extern UINT32 *aChangeLastStepW;
     aDecPromVarsList[j]   variable # of the jth decreasing promising Variable list
 */
 
-extern UINT32 *aDecPromVarsList;
-extern UINT32 iNumDecPromVars;
+extern THREADLOCAL UINT32 *aDecPromVarsList;
+extern THREADLOCAL UINT32 iNumDecPromVars;
 
-extern UINT32 *aDecPromVarsListW;
-extern UINT32 iNumDecPromVarsW;
+extern THREADLOCAL UINT32 *aDecPromVarsListW;
+extern THREADLOCAL UINT32 iNumDecPromVarsW;
 
 
 /***** Trigger BestScoreList *****/
@@ -213,9 +229,9 @@ extern UINT32 iNumDecPromVarsW;
     *aBestScoreListPos[j]   the location of variable[j] in aBestScoreList
 */
 
-extern UINT32 iNumBestScoreList;
-extern UINT32 *aBestScoreList;
-extern UINT32 *aBestScoreListPos;
+extern THREADLOCAL UINT32 iNumBestScoreList;
+extern THREADLOCAL UINT32 *aBestScoreList;
+extern THREADLOCAL UINT32 *aBestScoreListPos;
 
 
 /***** Trigger ClausePenaltyFL *****/
@@ -227,11 +243,11 @@ extern UINT32 *aBestScoreListPos;
     fTotalPenaltyFL         sum of all penalties
 */
 
-extern FLOAT *aClausePenaltyFL;
-extern BOOL bClausePenaltyCreated;
-extern BOOL bClausePenaltyFLOAT;
-extern FLOAT fBasePenaltyFL;
-extern FLOAT fTotalPenaltyFL;
+extern THREADLOCAL FLOAT *aClausePenaltyFL;
+extern THREADLOCAL BOOL bClausePenaltyCreated;
+extern THREADLOCAL BOOL bClausePenaltyFLOAT;
+extern THREADLOCAL FLOAT fBasePenaltyFL;
+extern THREADLOCAL FLOAT fTotalPenaltyFL;
 
 
 /***** Trigger MakeBreakPenaltyFL *****/
@@ -240,8 +256,8 @@ extern FLOAT fTotalPenaltyFL;
     aBreakPenaltyFL[j]      (same as aBreakCount, but as a sum of dynaimc clause penalties)  
 */
 
-extern FLOAT *aMakePenaltyFL;
-extern FLOAT *aBreakPenaltyFL;
+extern THREADLOCAL FLOAT *aMakePenaltyFL;
+extern THREADLOCAL FLOAT *aBreakPenaltyFL;
 
 
 /***** Trigger ClausePenaltyINT *****/
@@ -254,10 +270,10 @@ extern FLOAT *aBreakPenaltyFL;
     iTotalPenaltyINT         sum of all penalties
 */
 
-extern UINT32 *aClausePenaltyINT;
-extern UINT32 iInitPenaltyINT;
-extern UINT32 iBasePenaltyINT;
-extern UINT32 iTotalPenaltyINT;
+extern THREADLOCAL UINT32 *aClausePenaltyINT;
+extern THREADLOCAL UINT32 iInitPenaltyINT;
+extern THREADLOCAL UINT32 iBasePenaltyINT;
+extern THREADLOCAL UINT32 iTotalPenaltyINT;
 
 
 /***** Trigger MakeBreakPenaltyINT *****/
@@ -266,8 +282,8 @@ extern UINT32 iTotalPenaltyINT;
     aBreakPenaltyINT[j]      (same as aBreakCount, but as a sum of dynaimc clause penalties)  
 */
 
-extern UINT32 *aMakePenaltyINT;
-extern UINT32 *aBreakPenaltyINT;
+extern THREADLOCAL UINT32 *aMakePenaltyINT;
+extern THREADLOCAL UINT32 *aBreakPenaltyINT;
 
 
 /***** Trigger NullFlips *****/
@@ -275,7 +291,7 @@ extern UINT32 *aBreakPenaltyINT;
     iNumNullFlips         number of null flips (steps where iFlipCandidate == 0)
 */
 
-extern UINT32 iNumNullFlips;
+extern THREADLOCAL UINT32 iNumNullFlips;
 
  
 /***** Trigger LocalMins *****/
@@ -283,7 +299,7 @@ extern UINT32 iNumNullFlips;
     LocalMins              number of local minima encountered this run
 */
 
-extern UINT32 iNumLocalMins;
+extern THREADLOCAL UINT32 iNumLocalMins;
 
 
 /***** Trigger LogDist *****/
@@ -293,9 +309,9 @@ extern UINT32 iNumLocalMins;
     iLogDistStepsPerDecade    # of elements in aLogDistValues per decade
 */
 
-extern UINT32 *aLogDistValues;
-extern UINT32 iNumLogDistValues;
-extern UINT32 iLogDistStepsPerDecade;
+extern THREADLOCAL UINT32 *aLogDistValues;
+extern THREADLOCAL UINT32 iNumLogDistValues;
+extern THREADLOCAL UINT32 iLogDistStepsPerDecade;
 
 
 /***** Trigger BestFalse *****/
@@ -306,17 +322,17 @@ extern UINT32 iLogDistStepsPerDecade;
     iBestStepSumFalseW        step where iBestSumFalseW occured
 */
 
-extern UINT32 iBestNumFalse;
-extern UINT32 iBestStepNumFalse;
-extern FLOAT fBestSumFalseW;
-extern UINT32 iBestStepSumFalseW;
+extern THREADLOCAL UINT32 iBestNumFalse;
+extern THREADLOCAL UINT32 iBestStepNumFalse;
+extern THREADLOCAL FLOAT fBestSumFalseW;
+extern THREADLOCAL UINT32 iBestStepSumFalseW;
 
 
 /***** Trigger SaveBest *****/
 /*
     vsBest                the candidate solution for the best solution quality seen this run   
 */
-extern VARSTATE vsBest;
+extern THREADLOCAL VARSTATE vsBest;
 
 
 /***** Trigger StartFalse *****/
@@ -325,8 +341,8 @@ extern VARSTATE vsBest;
     fStartSumFalseW           value of fSumFalseW on Step 1
 */
 
-extern UINT32 iStartNumFalse;
-extern FLOAT fStartSumFalseW;
+extern THREADLOCAL UINT32 iStartNumFalse;
+extern THREADLOCAL FLOAT fStartSumFalseW;
 
 
 /***** Trigger ImproveMean *****/
@@ -335,8 +351,8 @@ extern FLOAT fStartSumFalseW;
     fImproveMeanW             Mean Improvement per Step to Best Solution Quality
 */
 
-extern FLOAT fImproveMean;
-extern FLOAT fImproveMeanW;
+extern THREADLOCAL FLOAT fImproveMean;
+extern THREADLOCAL FLOAT fImproveMeanW;
 
 
 /***** Trigger FirstLM *****/
@@ -348,10 +364,10 @@ extern FLOAT fImproveMeanW;
     iFirstLMStepW             step of the first weighted local minimum encountered
 */
 
-extern UINT32 iFirstLM;
-extern UINT32 iFirstLMStep;
-extern FLOAT fFirstLMW;
-extern UINT32 iFirstLMStepW;
+extern THREADLOCAL UINT32 iFirstLM;
+extern THREADLOCAL UINT32 iFirstLMStep;
+extern THREADLOCAL FLOAT fFirstLMW;
+extern THREADLOCAL UINT32 iFirstLMStepW;
 
 
 /***** Trigger FirstLMRatio *****/
@@ -361,8 +377,8 @@ extern UINT32 iFirstLMStepW;
     fFirstLMRatioW            (fStartSumFalseW - fFirstLMW) / (fStartSumFalseW - fBestSumFalseW)
 */
 
-extern FLOAT fFirstLMRatio;
-extern FLOAT fFirstLMRatioW;
+extern THREADLOCAL FLOAT fFirstLMRatio;
+extern THREADLOCAL FLOAT fFirstLMRatioW;
 
 
 /***** Trigger TrajBestLM *****/
@@ -374,10 +390,10 @@ extern FLOAT fFirstLMRatioW;
     fTrajBestLMMeanCVW        Weighted CV of Sol. Quality @ ... 
 */
 
-extern FLOAT fTrajBestLMMean;
-extern FLOAT fTrajBestLMMeanW;
-extern FLOAT fTrajBestLMCV;
-extern FLOAT fTrajBestLMCVW;
+extern THREADLOCAL FLOAT fTrajBestLMMean;
+extern THREADLOCAL FLOAT fTrajBestLMMeanW;
+extern THREADLOCAL FLOAT fTrajBestLMCV;
+extern THREADLOCAL FLOAT fTrajBestLMCVW;
 
 
 /***** Trigger NoImprove *****/
@@ -385,7 +401,7 @@ extern FLOAT fTrajBestLMCVW;
     iNoImprove            terminate this run if no improvement in iNoImprove steps
 */
 
-extern UINT32 iNoImprove;
+extern THREADLOCAL UINT32 iNoImprove;
 
 
 /***** Trigger StartSeed *****/
@@ -393,7 +409,7 @@ extern UINT32 iNoImprove;
     iStartSeed            starting seed required to duplicate the current run
 */
 
-extern UINT32 iStartSeed;
+extern THREADLOCAL UINT32 iStartSeed;
 
 
 /***** Trigger CountRandom *****/
@@ -415,7 +431,7 @@ extern UINT32 iStartSeed;
     aFlipCounts[j]        # of times that variable[j] has been flipped this run
 */
 
-extern UINT32 *aFlipCounts;
+extern THREADLOCAL UINT32 *aFlipCounts;
 
 
 /***** Trigger FlipCountStats *****/
@@ -425,9 +441,9 @@ extern UINT32 *aFlipCounts;
     fFlipCountsCV         CV of aFlipCounts[] excluding [0] (NullFlips)
 */
 
-extern FLOAT fFlipCountsMean;
-extern FLOAT fFlipCountsCV;
-extern FLOAT fFlipCountsStdDev;
+extern THREADLOCAL FLOAT fFlipCountsMean;
+extern THREADLOCAL FLOAT fFlipCountsCV;
+extern THREADLOCAL FLOAT fFlipCountsStdDev;
 
 
 /***** Trigger BiasCounts *****/
@@ -436,8 +452,8 @@ extern FLOAT fFlipCountsStdDev;
     aBiasFalseCounts[j] # of steps that variable[j] has been False
 */
 
-extern UINT32 *aBiasTrueCounts;
-extern UINT32 *aBiasFalseCounts;
+extern THREADLOCAL UINT32 *aBiasTrueCounts;
+extern THREADLOCAL UINT32 *aBiasFalseCounts;
 
 
 /***** Trigger BiasStats *****/
@@ -446,8 +462,8 @@ extern UINT32 *aBiasFalseCounts;
     fMeanMaxBias      Mean Fraction of # steps each variable was in its most frequent state
 */
 
-extern FLOAT fMeanFinalBias;
-extern FLOAT fMeanMaxBias;
+extern THREADLOCAL FLOAT fMeanFinalBias;
+extern THREADLOCAL FLOAT fMeanMaxBias;
 
 
 /***** Trigger UnsatCounts *****/
@@ -455,7 +471,7 @@ extern FLOAT fMeanMaxBias;
     aUnsatCounts[j]       # of steps that clause[j] has been unsatisfied
 */
 
-extern UINT32 *aUnsatCounts;
+extern THREADLOCAL UINT32 *aUnsatCounts;
 
 
 /***** Trigger UnsatCountStats *****/
@@ -465,9 +481,9 @@ extern UINT32 *aUnsatCounts;
     fUnsatCountsCV        CV of aUnsatCounts[]
 */
 
-extern FLOAT fUnsatCountsMean;
-extern FLOAT fUnsatCountsCV;
-extern FLOAT fUnsatCountsStdDev;
+extern THREADLOCAL FLOAT fUnsatCountsMean;
+extern THREADLOCAL FLOAT fUnsatCountsCV;
+extern THREADLOCAL FLOAT fUnsatCountsStdDev;
 
 
 /***** Trigger NumFalseCounts *****/
@@ -476,8 +492,8 @@ extern FLOAT fUnsatCountsStdDev;
     aNumFalseCountsWindow[j]  NumFalse values for the last iReportFalseHistCount steps
 */
 
-extern UINT32 *aNumFalseCounts;
-extern UINT32 *aNumFalseCountsWindow;
+extern THREADLOCAL UINT32 *aNumFalseCounts;
+extern THREADLOCAL UINT32 *aNumFalseCountsWindow;
 
 
 /***** Trigger DistanceCounts *****/
@@ -486,8 +502,8 @@ extern UINT32 *aNumFalseCountsWindow;
     aDistanceCountsWindow[j]  Hamming Distance values for the last iReportDistHistCount steps
 */
 
-extern UINT32 *aDistanceCounts;
-extern UINT32 *aDistanceCountsWindow;
+extern THREADLOCAL UINT32 *aDistanceCounts;
+extern THREADLOCAL UINT32 *aDistanceCountsWindow;
 
 
 /***** Trigger ClauseLast *****/
@@ -495,7 +511,7 @@ extern UINT32 *aDistanceCountsWindow;
     aClauseLast[j]        last step # for which clause[j] was unsatisfied
 */
 
-extern UINT32 *aClauseLast;
+extern THREADLOCAL UINT32 *aClauseLast;
 
 
 /***** Trigger ClauseLast *****/
@@ -504,8 +520,8 @@ extern UINT32 *aClauseLast;
     aSQGridW[j][k]        for run [k], solution quality at step aLogDistValues[j]
 */
 
-extern FLOAT *aSQGridW;
-extern UINT32 *aSQGrid;
+extern THREADLOCAL FLOAT *aSQGridW;
+extern THREADLOCAL UINT32 *aSQGrid;
 
 /***** Trigger PenaltyStats *****/
 /*
@@ -514,19 +530,19 @@ extern UINT32 *aSQGrid;
     aPenaltyStatsCV[j]      for current run, clause j, Clause Penalty CV
 */
 
-extern FLOAT *aPenaltyStatsMean;
-extern FLOAT *aPenaltyStatsStddev;
-extern FLOAT *aPenaltyStatsCV;
+extern THREADLOCAL FLOAT *aPenaltyStatsMean;
+extern THREADLOCAL FLOAT *aPenaltyStatsStddev;
+extern THREADLOCAL FLOAT *aPenaltyStatsCV;
 
-extern FLOAT *aPenaltyStatsSum;
-extern FLOAT *aPenaltyStatsSum2;
+extern THREADLOCAL FLOAT *aPenaltyStatsSum;
+extern THREADLOCAL FLOAT *aPenaltyStatsSum2;
 
-extern FLOAT *aPenaltyStatsMeanSum;
-extern FLOAT *aPenaltyStatsMeanSum2;
-extern FLOAT *aPenaltyStatsStddevSum;
-extern FLOAT *aPenaltyStatsStddevSum2;
-extern FLOAT *aPenaltyStatsCVSum;
-extern FLOAT *aPenaltyStatsCVSum2;
+extern THREADLOCAL FLOAT *aPenaltyStatsMeanSum;
+extern THREADLOCAL FLOAT *aPenaltyStatsMeanSum2;
+extern THREADLOCAL FLOAT *aPenaltyStatsStddevSum;
+extern THREADLOCAL FLOAT *aPenaltyStatsStddevSum2;
+extern THREADLOCAL FLOAT *aPenaltyStatsCVSum;
+extern THREADLOCAL FLOAT *aPenaltyStatsCVSum2;
 
 
 /***** Trigger VarFlipHistory *****/
@@ -535,8 +551,8 @@ extern FLOAT *aPenaltyStatsCVSum2;
     iVarFlipHistoryLen      size of circular array aVarFlipHistory [default = 2 * #Vars]
 */
 
-extern UINT32 *aVarFlipHistory;
-extern UINT32 iVarFlipHistoryLen;
+extern THREADLOCAL UINT32 *aVarFlipHistory;
+extern THREADLOCAL UINT32 iVarFlipHistoryLen;
 
 
 
@@ -547,9 +563,9 @@ extern UINT32 iVarFlipHistoryLen;
     aMobilityWindowSum2[j]  Cumulative sum of aMobilityWindow[j] ^2
 */
 
-extern UINT32 *aMobilityWindow;
-extern FLOAT *aMobilityWindowSum;
-extern FLOAT *aMobilityWindowSum2;
+extern THREADLOCAL UINT32 *aMobilityWindow;
+extern THREADLOCAL FLOAT *aMobilityWindowSum;
+extern THREADLOCAL FLOAT *aMobilityWindowSum2;
 
 
 /***** Trigger MobilityFixedFrequencies *****/
@@ -557,7 +573,7 @@ extern FLOAT *aMobilityWindowSum2;
     aMobilityFixedFrequencies[j]  # of times value j has occured for aMobilityWindow[iMobFixedWindow]
 */
 
-extern UINT32 *aMobilityFixedFrequencies;
+extern THREADLOCAL UINT32 *aMobilityFixedFrequencies;
 
 
 
@@ -569,10 +585,10 @@ extern UINT32 *aMobilityFixedFrequencies;
     aAutoCorrValues     Auto-correlation values (calculated at the end of each run)
 */
 
-extern UINT32 iAutoCorrMaxLen;
-extern FLOAT fAutoCorrCutoff;
-extern UINT32 iAutoCorrLen;
-extern FLOAT *aAutoCorrValues;
+extern THREADLOCAL UINT32 iAutoCorrMaxLen;
+extern THREADLOCAL FLOAT fAutoCorrCutoff;
+extern THREADLOCAL UINT32 iAutoCorrLen;
+extern THREADLOCAL FLOAT *aAutoCorrValues;
 
 
 
@@ -582,8 +598,8 @@ extern FLOAT *aAutoCorrValues;
     fAutoCorrOneEst     Estimated ACL from fAutoCorrOneVal = -1/ln(|.|)
 */
 
-extern FLOAT fAutoCorrOneVal;
-extern FLOAT fAutoCorrOneEst;
+extern THREADLOCAL FLOAT fAutoCorrOneVal;
+extern THREADLOCAL FLOAT fAutoCorrOneEst;
 
 
 
@@ -593,8 +609,8 @@ extern FLOAT fAutoCorrOneEst;
     fBranchFactorW      Weighted Branching Factor: # "sideways" step vars / # vars
 */
 
-extern FLOAT fBranchFactor;
-extern FLOAT fBranchFactorW;
+extern THREADLOCAL FLOAT fBranchFactor;
+extern THREADLOCAL FLOAT fBranchFactorW;
 
 
 
@@ -605,12 +621,12 @@ extern FLOAT fBranchFactorW;
     iNumSideSteps       Number of "sideways" steps this run
 */
   
-extern UINT32 iNumUpSteps;
-extern UINT32 iNumDownSteps;
-extern UINT32 iNumSideSteps;
-extern UINT32 iNumUpStepsW;
-extern UINT32 iNumDownStepsW;
-extern UINT32 iNumSideStepsW;
+extern THREADLOCAL UINT32 iNumUpSteps;
+extern THREADLOCAL UINT32 iNumDownSteps;
+extern THREADLOCAL UINT32 iNumSideSteps;
+extern THREADLOCAL UINT32 iNumUpStepsW;
+extern THREADLOCAL UINT32 iNumDownStepsW;
+extern THREADLOCAL UINT32 iNumSideStepsW;
 
 
 /***** Trigger NumRestarts *****/
@@ -618,7 +634,7 @@ extern UINT32 iNumSideStepsW;
     iNumRestarts        Number of Restarts (excl. initialization)
 */
   
-extern UINT32 iNumRestarts;
+extern THREADLOCAL UINT32 iNumRestarts;
 
 
 /***** Trigger LoadKnownSolutions *****/
@@ -627,8 +643,8 @@ extern UINT32 iNumRestarts;
     vslKnownSoln            VARSTATELIST of Known Solutions
 */
 
-extern VARSTATELIST vslKnownSoln;
-extern BOOL bKnownSolutions;
+extern THREADLOCAL VARSTATELIST vslKnownSoln;
+extern THREADLOCAL BOOL bKnownSolutions;
 
 
 /***** Trigger SolutionDistance *****/
@@ -636,7 +652,7 @@ extern BOOL bKnownSolutions;
     iSolutionDistance       Current Distance from Known Solution(s)
 */
 
-extern UINT32 iSolutionDistance;
+extern THREADLOCAL UINT32 iSolutionDistance;
 
 
 /***** Trigger FDCRun *****/
@@ -644,7 +660,7 @@ extern UINT32 iSolutionDistance;
     fFDCRun                 FDC for the current run (updated at end), using LM points only
 */
 
-extern FLOAT fFDCRun;
+extern THREADLOCAL FLOAT fFDCRun;
 
 
 /***** Trigger DynamicParms *****/
@@ -663,6 +679,6 @@ extern FLOAT fFDCRun;
     iLastUnique             Run of the last unique solution found
 */
 
-extern VARSTATELIST vslUnique;
-extern UINT32 iNumUniqueSolutions;
-extern UINT32 iLastUnique;
+extern THREADLOCAL VARSTATELIST vslUnique;
+extern THREADLOCAL UINT32 iNumUniqueSolutions;
+extern THREADLOCAL UINT32 iLastUnique;
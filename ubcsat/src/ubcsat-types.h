@@ -76,6 +76,10 @@
 
 #define UINT32MAX 0xFFFFFFFF
 
+#ifndef UINT64
+#define UINT64 unsigned long long
+#endif
+
 #ifndef SINT32
 #define SINT32 signed long
 #endif
@@ -95,6 +99,13 @@
 #define NULL 0
 #endif
 
+/* every global that a run modifies is THREADLOCAL, so each thread is a separate
+   UBCSAT context over the shared instance (see bInstanceShared) */
+
+#ifndef THREADLOCAL
+#define THREADLOCAL __thread
+#endif
+
 enum EVENTPOINT
 {
   PostParameters,
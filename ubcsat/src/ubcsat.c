@@ -132,6 +132,8 @@ int ubcsatcleanup() {
 
   CleanExit();
 
+  FreeSharedRAM();
+
   return(0);
   
 }
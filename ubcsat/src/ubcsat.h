@@ -38,6 +38,7 @@
 
 #include "ubcsat-limits.h"
 #include "ubcsat-types.h"
+#include "ubcsat-bitset.h"
 
 #include "ubcsat-lit.h"
 #include "ubcsat-mem.h"
@@ -55,13 +56,17 @@
 /* for UCT variants */
 #define MAX_NUM_VARS 2500 
 #define MAX_NUM_CLAUSES 10000
-short varMutable[MAX_NUM_VARS+1];
-short preSat[MAX_NUM_CLAUSES];
-short alwaysSat[MAX_NUM_CLAUSES];
-short bPresatTerminate;
-BOOL closedFlag; // used for closing nodes
+extern THREADLOCAL BITWORD varMutable[BitsetWords(MAX_NUM_VARS+1)];
+extern THREADLOCAL BITWORD preSat[BitsetWords(MAX_NUM_CLAUSES)];
+extern BITWORD alwaysSat[BitsetWords(MAX_NUM_CLAUSES)];
+extern THREADLOCAL short bPresatTerminate;
+extern THREADLOCAL BOOL closedFlag; // used for closing nodes
 
-int bestSoln[MAX_NUM_VARS+1];
+extern THREADLOCAL int bestSoln[MAX_NUM_VARS+1];
+
+#define IsMutable(V) GetBit(varMutable,V)
+#define SetImmutable(V) ClearBit(varMutable,V)
+#define IsPreSat(C) GetBit(preSat,C)
 
 #endif
 
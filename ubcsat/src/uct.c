@@ -1,11 +1,11 @@
 /* Class implementing UCTMAXSAT, UCT for MaxSAT
  * Leaf node value estimation is performed by short runs of the UBCSAT SLS algorithms
  *
- * The <varMutable> array defined in ubcsat.h tells which variables are mutable and which
- * are not during the SLS runs: varMutable[varNum] = TRUE or FALSE
+ * The <varMutable> bitset defined in ubcsat.h tells which variables are mutable and which
+ * are not during the SLS runs: IsMutable(varNum) = TRUE or FALSE
  *
- * The <preSat> array defined in ubcsat.h tells which clauses have truth values that
- * are determined by the set of immutable variables: preSat[clauseNum] = TRUE or FALSE
+ * The <preSat> bitset defined in ubcsat.h tells which clauses have truth values that
+ * are determined by the set of immutable variables: IsPreSat(clauseNum) = TRUE or FALSE
  *
  * UCT-compatible variants of the basic UBCSAT algorithms are defined in mylocal.c
  *
@@ -21,6 +21,10 @@
 
  
 #include "ubcsat.h"
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 const char sVersion[] = "1.1.0 (Sea to Sky Release)";  // UBCSAT version info
 
@@ -34,6 +38,14 @@ const char sVersion[] = "1.1.0 (Sea to Sky Release)";  // UBCSAT version info
 
 // for leaf node value estimation
 #define MIN_REWARD 0.0
+#define DEADLINE_CHECK 256 // SLS steps between two reads of the clock
+
+// hot-path counters, only updated in builds with -DUCT_STATS
+#ifdef UCT_STATS
+#define STATS(...) __VA_ARGS__
+#else
+#define STATS(...)
+#endif
 
 
 /* Data structure for UCT search -- maintained for each node in search tree */
@@ -62,16 +74,33 @@ void printMemoryError();
 uctnode *getNewNode(uctnode *parent, int armNum);
 void createChildren(uctnode *node);
 void freeNode(uctnode *node);
+void countTreeBytes(long bytes);
 void ubcsatsetup(int argc, char *argv[]);
 int ubcsatrun();
+void recordImprovement(int numUnsat, double cost);
+void printStats(const char *label, double elapsed);
+void reportStats();
+void hwStart();
+void hwStop();
+void hwSample(int phase);
+BOOL resultKey(const char *name);
+void resultInt(const char *name, long value);
+void resultDouble(const char *name, double value);
+void resultNull(const char *name);
+void resultString(const char *name, const char *value);
+void resultModel(const char *name, UINT32 *soln, int n);
+void writeResultFields(int run, double cost);
+void writeResult(int run, double cost);
 void ubcsatcleanup();
 void setMutable();
 void setPreSat();
+void setHardClauses();
+void countFalseW();
+double runCostW();
 void printParams();
 void printUsageError();
-int runUCT();
-int runUCTtimed();
-void ALARMhandler(int sig);
+double runUCT();
+double runUCTtimed();
 void performRuns();
 
 
@@ -84,20 +113,107 @@ double p = 0.0; // noise parameter for SLS algorithm
 sls_type slsAlg = WALKSAT; // SLS algorithm used for leaf node value estimation
 char *filename; // .cnf filename
 BOOL timed = FALSE; // whether each run has a time limit
-int runTimeout = 15; // run timeout in seconds -- only applies if timed == TRUE
+double runTimeout = 15; // run timeout in seconds -- only applies if timed == TRUE
+BOOL cpuTimeout = FALSE; // whether the run timeout is measured in process cpu time instead of wall time
+BOOL seeded = FALSE; // whether the random seed is given on the command line
+UINT32 masterSeed; // the given random seed -- only applies if seeded == TRUE
+BOOL legacyRandom = FALSE; // use the Mersenne Twister with modulo sampling instead of xoshiro256**
+BOOL weighted = FALSE; // whether the clause weights of a .wcnf file are used, with its hard clauses
 
 /* GLOBAL VARIABLES */
 int depthLimit; // maximum depth a node may have
 uctnode* root; // pointer to root node of UCT search tree
 UINT32 nextBranchingAtom; // the next atom to branch on given the current formula
-BOOL timeFlag; // used for timeouts
-clock_t start, stop; // used for timeouts
-BOOL clockStopped; // used for timeouts
+BOOL timeFlag; // cleared when the run deadline has passed
 double bestReward;
 double bestRewardAtTimeout;
 int runBestNumFalse;
 int iterationNum;
 
+/* WEIGHTED AND PARTIAL MAXSAT -- with -w, the SLS minimizes the weight of the unsat clauses,
+   hard clauses weighing the top weight of the .wcnf file. The unsat hard clauses are counted
+   apart: a leaf whose best assignment leaves some unsat is infeasible and earns MIN_REWARD,
+   and a leaf whose immutable variables falsify a hard clause is closed without SLS. */
+BITWORD hardClause[BitsetWords(MAX_NUM_CLAUSES)]; // the hard clauses, none without -w
+int numHard; // number of hard clauses
+FLOAT softWeight; // sum of the weights of the soft clauses
+// setPreSat() and ubcsatrun() update the leaf and run state below, so like UBCSAT's own
+// run state it is per thread
+THREADLOCAL BOOL infeasibleFlag; // set by setPreSat when the immutable variables falsify a hard clause
+THREADLOCAL int leafHardFalse; // unsat hard clauses of the best assignment of the last SLS run
+THREADLOCAL FLOAT leafSoftFalseW; // weight of its unsat soft clauses
+int runBestHard; // unsat hard clauses of the best assignment of the current run
+
+/* ANYTIME PROFILE */
+typedef struct trajectorypoint {
+  double time; // wall time since the start of the run, in seconds
+  int iteration; // UCT iteration
+  int nodes; // size of the UCT tree
+  UINT32 flips; // SLS flips in the run
+  int numUnsat; // number of unsat clauses of the new best assignment
+  double cost; // its cost: numUnsat, or the weight of its unsat clauses with -w
+} trajectorypoint;
+
+BOOL printTrajectory = FALSE; // whether to print the anytime profile of each run
+trajectorypoint **profiles; // profiles[i] lists the improvements of run i
+int *profileLen; // number of improvements of each run
+int runNum; // the current run
+double runStart; // wall time at which the current run started
+int treeNodes; // size of the UCT tree of the current run
+THREADLOCAL UINT32 runFlips; // flips of the finished SLS runs of the current run, per thread like infeasibleFlag
+THREADLOCAL double trajectoryBest; // best cost of the current run
+
+/* HARDWARE COUNTERS -- with -x, a group of perf_event counters is opened at the start of
+   each run and sampled at every phase boundary of the UCT loop. The counts since the
+   previous sample are charged to the phase that just ended: leaf setup (setPreSat), SLS
+   (ubcsatrun), branching (setBranchingAtom), and descent for everything else, mostly
+   playNode. A sample is one read() of the group. Events the kernel refuses
+   (perf_event_paranoid, virtual machines without a PMU) are reported as n/a. */
+enum {HW_CYCLES, HW_INSTRUCTIONS, HW_L1D_MISSES, HW_LLC_MISSES, HW_BRANCH_MISSES, HW_EVENTS};
+enum {HW_DESCENT, HW_SETUP, HW_SLS, HW_BRANCHING, HW_PHASES};
+
+const char *hwEventNames[HW_EVENTS] = {"cycles", "instructions", "L1d misses", "LLC misses", "branch misses"};
+const char *hwPhaseNames[HW_PHASES] = {"descent", "setup", "sls", "branching"};
+
+BOOL hwEnabled = FALSE; // whether -x asks for the counters
+int hwFd[HW_EVENTS] = {-1, -1, -1, -1, -1}; // -1 for the events not opened, hwFd[0] leads the group
+int hwSlot[HW_EVENTS] = {-1, -1, -1, -1, -1}; // position of each event in a group read, -1 if it is not counted
+int hwSize = 0; // number of events in the group
+UINT64 hwLast[HW_EVENTS]; // counts at the previous sample
+
+/* HOT-PATH COUNTERS -- times are in seconds, the descent is the part of the iteration
+   time spent outside of leaf evaluations */
+typedef struct uctstats {
+  int evaluations; // leaf evaluations, one SLS run each
+  long leafDepth; // sum of the depths of the evaluated leaves
+  int closedArms;
+  double initTime; // setPreSat()
+  double slsTime; // ubcsatrun()
+  double branchTime; // setBranchingAtom()
+  double iterationTime; // whole UCT iterations
+  UINT64 hw[HW_PHASES][HW_EVENTS]; // hardware counts of each phase, with -x
+} uctstats;
+
+uctstats stats; // counters of the current run
+double statsInterval = 0; // seconds between periodic reports of the counters, 0 for none
+double nextStatsReport; // time of the next periodic report
+long treeBytes; // bytes held by the UCT tree
+long peakTreeBytes; // peak of <treeBytes> in the current run
+int maxDepth; // depth of the deepest leaf played in the current run
+
+/* RESULTS FILE -- with -o, one record per run is written as soon as the run ends: a JSON
+   object per line, or a CSV row under a header line if the file name ends in .csv. A
+   missing value is null in JSON and an empty cell in CSV. */
+#define RESULTS_BUFFER (1<<20)
+
+FILE *resultsFile = NULL; // NULL without -o
+BOOL resultsCsv = FALSE;
+BOOL resultsHeader = FALSE; // whether the CSV header is being written instead of a record
+int resultsFields; // fields written so far in the current record
+int resultsRecords = 0; // records written so far
+BOOL printModel = FALSE; // whether the records carry the best assignment of their run
+UINT32 runModel[MAX_NUM_VARS+1]; // best assignment of the current run, kept with -v only
+
 
 /* Main UCT Method -- Plays the selected node */
 double playNode(uctnode *node) {
@@ -105,17 +221,20 @@ double playNode(uctnode *node) {
   short armPlayed;
   
   // Set this node's variable to be immutable
-  varMutable[node->atom] = FALSE;
+  SetImmutable(node->atom);
   
   // If neither arm has been played, play them both
   if (node->n[LEFT]==0) {
     node->n[LEFT] = node->n[RIGHT] = 1;
+    if (node->depth > maxDepth) maxDepth = node->depth;
+    STATS(stats.leafDepth += BF*node->depth);
     // play the left arm
     aVarValue[node->atom] = LEFT;
     node->x[LEFT] = estimateReward();
     if (closedFlag) {
       closedFlag=FALSE;
       node->closed[LEFT]=TRUE;
+      STATS(stats.closedArms++);
     }
     else {
       node->nextAtom[LEFT] = nextBranchingAtom;
@@ -126,6 +245,7 @@ double playNode(uctnode *node) {
     if (closedFlag) {
       closedFlag=FALSE;
       node->closed[RIGHT]=TRUE;
+      STATS(stats.closedArms++);
     }
     else  {
       node->nextAtom[RIGHT] = nextBranchingAtom;
@@ -134,6 +254,7 @@ double playNode(uctnode *node) {
     armPlayed = BOTH;
     // If the depth limit has been reached, close both arms
     if (node->depth >= depthLimit) {
+      STATS(stats.closedArms += !node->closed[LEFT] + !node->closed[RIGHT]);
       node->closed[LEFT] = node->closed[RIGHT] = TRUE;
     }
   }
@@ -144,6 +265,7 @@ double playNode(uctnode *node) {
     aVarValue[node->atom] = RIGHT;
     if (!(node->children)) {
       createChildren(node);
+      treeNodes += BF;
     }
     reward = playNode(node->children[RIGHT]);
     node->x[RIGHT]+=(reward-node->x[RIGHT])/node->n[RIGHT];
@@ -156,6 +278,7 @@ double playNode(uctnode *node) {
     aVarValue[node->atom] = LEFT;
     if (!(node->children)) {
       createChildren(node);
+      treeNodes += BF;
     }
     reward = playNode(node->children[LEFT]);
     node->x[LEFT]+=(reward-node->x[LEFT])/node->n[LEFT];
@@ -169,6 +292,7 @@ double playNode(uctnode *node) {
     aVarValue[node->atom] = armPlayed;
     if (!(node->children)) {
       createChildren(node);
+      treeNodes += BF;
     }
     reward = playNode(node->children[armPlayed]);
     node->x[armPlayed]+=(reward-node->x[armPlayed])/node->n[armPlayed];
@@ -179,13 +303,17 @@ double playNode(uctnode *node) {
   switch (armPlayed) {
       
   case (LEFT):
-    if (node->children[LEFT]->closed[LEFT] && node->children[LEFT]->closed[RIGHT])
+    if (node->children[LEFT]->closed[LEFT] && node->children[LEFT]->closed[RIGHT]) {
+      STATS(stats.closedArms += !node->closed[LEFT]);
       node->closed[LEFT] = TRUE;
+    }
     break;
           
   case (RIGHT):
-    if (node->children[RIGHT]->closed[LEFT] && node->children[RIGHT]->closed[RIGHT])
+    if (node->children[RIGHT]->closed[LEFT] && node->children[RIGHT]->closed[RIGHT]) {
+      STATS(stats.closedArms += !node->closed[RIGHT]);
       node->closed[RIGHT] = TRUE;
+    }
     break;
 
   }
@@ -215,17 +343,43 @@ short selectMove(uctnode *node) {
 /* Estimates the value of a leaf node by performing SLS */
 double estimateReward() {
   double reward;
+  STATS(double start = DeadlineClock(FALSE), searchStart, branchStart; hwSample(HW_DESCENT));
   
   // First update which clauses are pre-satisfied or pre-unsatisfied
   setPreSat();
-  // Then perform SLS using a UBCSAT SLS algorithm ...
-  reward = (double) (iNumClauses-ubcsatrun()) / (double) iNumClauses;
-  // and take the reward to be the portion of satisfied clauses squared
+  STATS(searchStart = DeadlineClock(FALSE); hwSample(HW_SETUP));
+  // A hard clause falsified by the immutable variables makes the whole subtree infeasible
+  if (infeasibleFlag) {
+    closedFlag = TRUE;
+    reward = MIN_REWARD;
+  }
+  // Otherwise perform SLS using a UBCSAT SLS algorithm ...
+  else if (weighted) {
+    ubcsatrun();
+    if (leafHardFalse) {
+      reward = MIN_REWARD;
+    }
+    else {
+      reward = (softWeight > FLOATZERO) ? (softWeight-leafSoftFalseW) / softWeight : 1.0;
+    }
+  }
+  else {
+    reward = (double) (iNumClauses-ubcsatrun()) / (double) iNumClauses;
+  }
+  STATS(branchStart = DeadlineClock(FALSE); hwSample(HW_SLS));
+  // and take the reward to be the portion of satisfied (soft) clauses squared
   reward *= reward;
   // Then determine which atom to branch on next
   if (!closedFlag) {
     setBranchingAtom();
   }
+  STATS(
+    hwSample(HW_BRANCHING);
+    stats.evaluations++;
+    stats.initTime += searchStart-start;
+    stats.slsTime += branchStart-searchStart;
+    stats.branchTime += DeadlineClock(FALSE)-branchStart;
+  )
   
   bestReward = (reward>bestReward) ? reward : bestReward;
   return reward;
@@ -241,7 +395,8 @@ int getNumUnsat(double reward) {
 /* Sets the next variable to branch on given the current formula.
  * Branching heuristic: A0 */
 void setBranchingAtom() {
-    UINT32 j, k;
+  UINT32 j, k, w;
+  BITWORD bits;
   int bestScore;
   UINT32 bestVars[iNumVars];
   int numBest = 0;
@@ -251,11 +406,15 @@ void setBranchingAtom() {
     varScores[j]=0;
   }
   
-  // Collect the variable scores
-  for (j=0; j<iNumClauses; j++) {
-    if (preSat[j]) continue; // don't consider preSat clauses
-    for (k=0;k<aClauseLen[j];k++) {
-      varScores[GetVar(j,k)]++;
+  // Collect the variable scores, skipping over preSat clauses a word at a time
+  for (w=0; w<BitsetWords(iNumClauses); w++) {
+    bits = ~preSat[w];
+    while (bits) {
+      j = (w << 6) + LowestBit(bits);
+      bits &= bits - 1;
+      for (k=0;k<aClauseLen[j];k++) {
+        varScores[GetVar(j,k)]++;
+      }
     }
   }
   
@@ -263,7 +422,7 @@ void setBranchingAtom() {
   bestScore = -1;
   
   for (j=1; j<=iNumVars; j++) {
-    if (!varMutable[j]) continue;
+    if (!IsMutable(j)) continue;
     
     if (varScores[j]>bestScore) {
       bestScore = varScores[j];
@@ -288,6 +447,8 @@ void setBranchingAtom() {
 /* Sets the root node of the UCT search tree */
 void setRootNode() {
   root = malloc(sizeof(uctnode));
+  treeNodes++;
+  STATS(countTreeBytes(sizeof(uctnode)));
   if (!root) printMemoryError();
   root->depth = 0;
   root->x[LEFT] = root->x[RIGHT] = MIN_REWARD;
@@ -320,6 +481,7 @@ void createChildren(uctnode *node) {
   int i;
   node->children = malloc(BF * sizeof(uctnode*));
   if (!node->children) printMemoryError();
+  STATS(countTreeBytes(BF * (sizeof(uctnode)+sizeof(uctnode*))));
   for (i=0; i<BF; i++) {
     node->children[i] = getNewNode(node, i);
   }
@@ -337,11 +499,23 @@ void freeNode(uctnode *node) {
     if (node->children[RIGHT]) {
       freeNode(node->children[RIGHT]);
     }
+    free(node->children);
+    STATS(countTreeBytes(-(long) (BF * sizeof(uctnode*))));
   }
+  STATS(countTreeBytes(-(long) sizeof(uctnode)));
   free(node);
 }
 
 
+/* Tracks the memory of the UCT tree and its peak */
+void countTreeBytes(long bytes) {
+  treeBytes += bytes;
+  if (treeBytes > peakTreeBytes) {
+    peakTreeBytes = treeBytes;
+  }
+}
+
+
 /* UBCSAT sets up its data structures */
 void ubcsatsetup(int argc, char *argv[]) {
   InitSeed();
@@ -361,6 +535,10 @@ void ubcsatsetup(int argc, char *argv[]) {
   RunProcedures(PostRead);
   RunProcedures(CreateData);
   RunProcedures(CreateStateInfo);
+  // the instance is read-only from here on, so other threads can share it
+  if (!bInstanceShared) {
+    bInstanceShared = TRUE;
+  }
   iRun = 0;
   iNumSolutionsFound = 0;
   bTerminateAllRuns = FALSE;
@@ -370,6 +548,241 @@ void ubcsatsetup(int argc, char *argv[]) {
 }
 
 
+/* Records an improvement of the best cost of the current run */
+void recordImprovement(int numUnsat, double cost) {
+  trajectorypoint *point;
+  int n = profileLen[runNum];
+  
+  // the profile of a run grows in powers of two
+  if ((n & (n-1))==0) {
+    profiles[runNum] = (trajectorypoint*) realloc(profiles[runNum], (n ? 2*n : 1)*sizeof(trajectorypoint));
+    if (!profiles[runNum]) printMemoryError();
+  }
+  point = &profiles[runNum][n];
+  point->time = DeadlineClock(FALSE) - runStart;
+  point->iteration = iterationNum;
+  point->nodes = treeNodes;
+  point->flips = runFlips + iStep;
+  point->numUnsat = numUnsat;
+  point->cost = cost;
+  profileLen[runNum] = n+1;
+  trajectoryBest = cost;
+  runBestHard = leafHardFalse;
+  if (printModel) {
+    memcpy(runModel, aVarValue, (iNumVars+1)*sizeof(UINT32));
+  }
+}
+
+
+/* Starts field <name> of the current record; returns whether its value is to be written */
+BOOL resultKey(const char *name) {
+  if (resultsFields++) fputc(',', resultsFile);
+  if (resultsHeader) {
+    fputs(name, resultsFile);
+    return FALSE;
+  }
+  if (!resultsCsv) fprintf(resultsFile, "\"%s\":", name);
+  return TRUE;
+}
+
+void resultInt(const char *name, long value) {
+  if (resultKey(name)) fprintf(resultsFile, "%ld", value);
+}
+
+void resultDouble(const char *name, double value) {
+  if (resultKey(name)) fprintf(resultsFile, "%.9g", value);
+}
+
+void resultNull(const char *name) {
+  if (resultKey(name) && !resultsCsv) fputs("null", resultsFile);
+}
+
+void resultString(const char *name, const char *value) {
+  if (!resultKey(name)) return;
+  fputc('"', resultsFile);
+  for (; *value; value++) {
+    if (*value=='"') fputc(resultsCsv ? '"' : '\\', resultsFile);
+    else if (*value=='\\' && !resultsCsv) fputc('\\', resultsFile);
+    fputc(*value, resultsFile);
+  }
+  fputc('"', resultsFile);
+}
+
+/* Assignment <soln> of variables 1..n: an array of 0/1 in JSON, a string of 0/1 in CSV */
+void resultModel(const char *name, UINT32 *soln, int n) {
+  int i;
+  if (!resultKey(name)) return;
+  fputc(resultsCsv ? '"' : '[', resultsFile);
+  for (i=1; i<=n; i++) {
+    if (i>1 && !resultsCsv) fputc(',', resultsFile);
+    fputc(soln[i] ? '1' : '0', resultsFile);
+  }
+  fputc(resultsCsv ? '"' : ']', resultsFile);
+}
+
+
+/* Writes the fields of the record of run <run>, whose result is <cost> */
+void writeResultFields(int run, double cost) {
+  int n = profileLen[run];
+  
+  resultsFields = 0;
+  if (!resultsCsv) fputc('{', resultsFile);
+  resultInt("run", run);
+  resultInt("seed", (long) iSeed);
+  resultDouble("cost", cost);
+  if (weighted && n) {
+    resultDouble("unsat_weight", cost);
+    resultInt("unsat_hard", runBestHard);
+  }
+  else {
+    resultNull("unsat_weight");
+    resultNull("unsat_hard");
+  }
+  if (n) {
+    resultInt("unsat_clauses", profiles[run][n-1].numUnsat);
+    resultDouble("time_to_best", profiles[run][n-1].time);
+  }
+  else {
+    resultNull("unsat_clauses");
+    resultNull("time_to_best");
+  }
+  resultDouble("time", DeadlineClock(FALSE) - runStart);
+  resultInt("iterations", iterationNum);
+  resultInt("flips", (long) runFlips);
+  resultInt("nodes", treeNodes);
+  resultInt("max_depth", maxDepth);
+  resultString("instance", filename);
+  resultString("sls", slsAlg==WALKSAT ? "WalkSAT" : "Novelty");
+  resultDouble("c", C);
+  resultDouble("noise", p);
+  resultInt("max_flips", maxFlips);
+  if (timed) {
+    resultDouble("timeout", runTimeout);
+  }
+  else {
+    resultNull("timeout");
+  }
+  resultString("clock", cpuTimeout ? "cpu" : "wall");
+  resultInt("max_iterations", numIterations);
+  resultString("generator", legacyRandom ? "Mersenne Twister" : "xoshiro256**");
+  if (printModel) {
+    if (n) {
+      resultModel("model", runModel, iNumVars);
+    }
+    else {
+      resultNull("model");
+    }
+  }
+  if (!resultsCsv) fputc('}', resultsFile);
+  fputc('\n', resultsFile);
+}
+
+
+/* Writes the record of run <run> to the results file, after the header of a CSV file */
+void writeResult(int run, double cost) {
+  if (resultsCsv && resultsRecords==0) {
+    resultsHeader = TRUE;
+    writeResultFields(run, cost);
+    resultsHeader = FALSE;
+  }
+  writeResultFields(run, cost);
+  resultsRecords++;
+}
+
+
+/* Prints the counters of the current run over <elapsed> seconds */
+void printStats(const char *label, double elapsed) {
+  double total = stats.iterationTime > 1e-9 ? stats.iterationTime : 1e-9;
+  double descent = stats.iterationTime - stats.initTime - stats.slsTime - stats.branchTime;
+  int p, e;
+  
+  if (elapsed < 1e-9) elapsed = 1e-9;
+  if (descent < 0) descent = 0;
+  printf("%s: %.0f flips/s, %.0f iterations/s, %.0f evals/s, init %.1f%% sls %.1f%% branching %.1f%% descent %.1f%%, "
+         "leaf depth %.2f, nodes %d, closed arms %d, peak tree %.2f MB\n", label,
+         (runFlips + iStep)/elapsed, iterationNum/elapsed, stats.evaluations/elapsed, 100*stats.initTime/total,
+         100*stats.slsTime/total, 100*stats.branchTime/total, 100*descent/total,
+         stats.evaluations ? stats.leafDepth/(double) stats.evaluations : 0.0, treeNodes,
+         stats.closedArms, peakTreeBytes/1048576.0);
+  
+  // with -x, one line per phase: its hardware counts and instructions per cycle
+  for (p=0; hwEnabled && p<HW_PHASES; p++) {
+    printf("%s %s:", label, hwPhaseNames[p]);
+    for (e=0; e<HW_EVENTS; e++) {
+      if (hwSlot[e]>=0) printf("%s %llu %s", e ? "," : "", (unsigned long long) stats.hw[p][e], hwEventNames[e]);
+      else printf("%s n/a %s", e ? "," : "", hwEventNames[e]);
+    }
+    if (hwSlot[HW_CYCLES]>=0 && hwSlot[HW_INSTRUCTIONS]>=0 && stats.hw[p][HW_CYCLES]) {
+      printf(", IPC %.2f", stats.hw[p][HW_INSTRUCTIONS]/(double) stats.hw[p][HW_CYCLES]);
+    }
+    printf("\n");
+  }
+  fflush(stdout);
+}
+
+
+/* Opens the hardware counters, leaving them closed if even the cycles counter fails */
+void hwStart() {
+  static const UINT64 config[HW_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16),
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  struct perf_event_attr attr;
+  int e;
+  
+  hwStop();
+  for (e=0; e<HW_EVENTS; e++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = (e==HW_L1D_MISSES) ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE;
+    attr.config = config[e];
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = (e==0);
+    hwFd[e] = syscall(__NR_perf_event_open, &attr, 0, -1, e ? hwFd[0] : -1, 0);
+    if (hwFd[0]<0) return;
+    if (hwFd[e]>=0) hwSlot[e] = hwSize++;
+  }
+  ioctl(hwFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  memset(hwLast, 0, sizeof(hwLast));
+  hwSample(HW_PHASES);
+}
+
+void hwStop() {
+  int e;
+  for (e=0; e<HW_EVENTS; e++) {
+    if (hwFd[e]>=0) close(hwFd[e]);
+    hwFd[e] = hwSlot[e] = -1;
+  }
+  hwSize = 0;
+}
+
+/* Charges the counts since the previous sample to <phase>, or drops them for HW_PHASES */
+void hwSample(int phase) {
+  UINT64 buf[1+HW_EVENTS];
+  int e;
+  
+  if (!hwSize || read(hwFd[0], buf, (1+hwSize)*sizeof(UINT64)) <= 0) return;
+  for (e=0; e<HW_EVENTS; e++) {
+    if (hwSlot[e]<0) continue;
+    if (phase<HW_PHASES) stats.hw[phase][e] += buf[1+hwSlot[e]] - hwLast[e];
+    hwLast[e] = buf[1+hwSlot[e]];
+  }
+}
+
+
+/* Prints the counters so far in the run, at most once every <statsInterval> seconds */
+void reportStats() {
+  double now = DeadlineClock(FALSE);
+  char label[32];
+  
+  if (now < nextStatsReport) return;
+  nextStatsReport = now + statsInterval;
+  sprintf(label, "Stats run %d at %.2fs", runNum, now - runStart);
+  printStats(label, now - runStart);
+}
+
+
 /* UBCSAT performs an SLS run, returns the best number of unsat clauses found */
 int ubcsatrun() {
   
@@ -416,10 +829,30 @@ int ubcsatrun() {
 
     RunProcedures(StepCalculations);
 
+    if (weighted) {
+      // a new best of this SLS run: count its unsat hard clauses apart
+      if (iBestStepSumFalseW == iStep) {
+        countFalseW();
+        if (fSumFalseW < trajectoryBest) {
+          recordImprovement(iNumFalse, fSumFalseW);
+        }
+      }
+    }
+    else if (iBestNumFalse < trajectoryBest) {
+      recordImprovement(iBestNumFalse, iBestNumFalse);
+    }
+
     RunProcedures(CheckTerminate);
+
+    // in a timed run, stop mid-playout at the deadline, reading the clock every DEADLINE_CHECK steps
+    if (timed && (iStep % DEADLINE_CHECK == 0) && DeadlinePassed()) {
+      timeFlag = FALSE;
+      bTerminateRun = TRUE;
+    }
   } 
 
   StopRunClock();
+  runFlips += iStep;
 
   RunProcedures(RunCalculations);
     
@@ -435,53 +868,63 @@ void ubcsatcleanup() {
   RunProcedures(FinalCalculations);
   RunProcedures(FinalReports);
   CleanExit();
+  FreeSharedRAM();
 }
 
 
 /* Sets <varMutable> array */
 void setMutable() {
-  int i;
-  for (i=0; i<=iNumVars; i++) {
-    varMutable[i] = TRUE;
-  }
+  SetAllBits(varMutable, iNumVars+1);
 }
 
 
 /* Sets the <preSat> array */
 void setPreSat() {
   // A clause is pre-satisfied if it contains a true immutable literal or all literals
-  // are immutable and false.
+  // are immutable and false. <preSat> is written a word at a time, and the bits past the
+  // last clause are left set so that scans over ~preSat never see them.
   
-  UINT32 j, k;
+  UINT32 j, k, w;
   LITTYPE *pLit;
   BOOL clausePresat;
+  BITWORD word;
   
   closedFlag = TRUE;
+  infeasibleFlag = FALSE;
   
-  for (j=0; j<iNumClauses; j++) {
-    if (alwaysSat[j]) {
-      preSat[j] = TRUE;
-      continue;
-    }
-    clausePresat = TRUE;
-    pLit = pClauseLits[j];
+  for (w=0; w<BitsetWords(iNumClauses); w++) {
+    word = BITWORDONES;
     
-    for (k=0; k<aClauseLen[j]; k++) {
-      if (varMutable[GetVarFromLit(*pLit)]) {
-        clausePresat = FALSE;
+    for (j=(w << 6); j<((w+1) << 6) && j<iNumClauses; j++) {
+      if (GetBit(alwaysSat,j)) {
+        continue;
       }
-      else if (IsLitTrue(*pLit)) {
-        clausePresat = TRUE;
-        break;
+      clausePresat = TRUE;
+      pLit = pClauseLits[j];
+      
+      for (k=0; k<aClauseLen[j]; k++) {
+        if (IsMutable(GetVarFromLit(*pLit))) {
+          clausePresat = FALSE;
+        }
+        else if (IsLitTrue(*pLit)) {
+          clausePresat = TRUE;
+          break;
+        }
+        pLit++;
+      }
+      
+      // without a true literal, a clause whose literals are all immutable is false for good
+      if (clausePresat && k==aClauseLen[j] && GetBit(hardClause,j)) {
+        infeasibleFlag = TRUE;
+      }
+      
+      if (!clausePresat) {
+        word &= ~(1ULL << (j & 63));
       }
-      pLit++;
-    }
-
-    if (clausePresat) {
-      preSat[j] = TRUE;
     }
-    else {
-      preSat[j] = FALSE;
+    
+    preSat[w] = word;
+    if (~word) {
       closedFlag = FALSE;
     }
   }
@@ -496,8 +939,9 @@ void setAlwaysSat() {
   LITTYPE *pLit, *pLit2;
   BOOL breakFlag = FALSE;
   
+  ClearAllBits(alwaysSat, iNumClauses);
+  
   for (j=0; j<iNumClauses; j++) {
-    alwaysSat[j] = FALSE;
     pLit = pClauseLits[j];
     
     for (k=0; k<aClauseLen[j]; k++) {
@@ -506,7 +950,7 @@ void setAlwaysSat() {
         pLit2=pLit;
         for (l=k+1; l<aClauseLen[j]; l++) {
           if (GetVarFromLit(*pLit2) == var && !GetLitSign(*pLit2)) {
-            alwaysSat[j] = TRUE;
+            SetBit(alwaysSat,j);
             breakFlag = TRUE;
             break;
           }
@@ -524,6 +968,51 @@ void setAlwaysSat() {
 }
 
 
+/* Sets the <hardClause> array from the weights of a partial .wcnf file */
+void setHardClauses() {
+  // hard clauses are the clauses whose weight reaches the top weight of the file
+  UINT32 j;
+  
+  ClearAllBits(hardClause, iNumClauses);
+  numHard = 0;
+  softWeight = FLOATZERO;
+  
+  for (j=0; j<iNumClauses; j++) {
+    if (fHardWeight > FLOATZERO && aClauseWeight[j] >= fHardWeight) {
+      SetBit(hardClause,j);
+      numHard++;
+    }
+    else {
+      softWeight += aClauseWeight[j];
+    }
+  }
+}
+
+
+/* Sets <leafHardFalse> and <leafSoftFalseW> from the current assignment */
+void countFalseW() {
+  UINT32 j;
+  
+  leafHardFalse = 0;
+  leafSoftFalseW = FLOATZERO;
+  
+  for (j=0; j<iNumFalse; j++) {
+    if (GetBit(hardClause,aFalseList[j])) {
+      leafHardFalse++;
+    }
+    else {
+      leafSoftFalseW += aClauseWeight[aFalseList[j]];
+    }
+  }
+}
+
+
+/* Returns the best cost of the current run with -w, the total weight if no leaf was evaluated */
+double runCostW() {
+  return (trajectoryBest <= fTotalWeight) ? trajectoryBest : fTotalWeight;
+}
+
+
 void printParams() {
   printf("Parameters:\n");
   printf("Instance: %s \n", filename);
@@ -531,6 +1020,8 @@ void printParams() {
   printf("UCT iterations per run: %d\n", numIterations);
   printf("UCT C param: %f\n", C);
   printf("UCT branching heuristic: A0\n");
+  if (weighted) printf("Weighted: yes, %d hard clauses, soft weight %.12g\n", numHard, softWeight);
+  else printf("Weighted: no\n");
   printf("SLS algorithm: ");
   if (slsAlg==WALKSAT)
     printf("WalkSAT\n");
@@ -540,8 +1031,12 @@ void printParams() {
   printf("Total SLS flips per run: %d\n", 2*maxFlips*numIterations);
   printf("SLS noise param: %f\n", p);
   printf("Bandit Algorithm: UCB1\n");
-  if (timed) printf("Timeout: %d (s)\n", runTimeout);
+  if (timed) printf("Timeout: %g (s, %s time)\n", runTimeout, cpuTimeout ? "cpu" : "wall");
   else printf("Timeout: NA\n");
+  printf("Random seed: %lu\n", (unsigned long) iSeed);
+  printf("Random generator: %s\n", legacyRandom ? "Mersenne Twister" : "xoshiro256**");
+  STATS(printf("Stats interval: %g\n", statsInterval));
+  STATS(printf("Hardware counters: %s\n", hwEnabled ? "on" : "off"));
   fflush(stdout);
 }
 
@@ -555,7 +1050,7 @@ void printMemoryError() {
 
 void printUsageError() {
   printf("\nusage: uct -f filename [-a INT] [-r INT] [-i INT] [-g INT] [-c DOUBLE] \n");
-  printf("[-p DOUBLE] [-m INT] [-n DOUBLE] [-b INT] [-t INT] [-o INT]\n\n");
+  printf("[-p DOUBLE] [-m INT] [-n DOUBLE] [-b INT] [-t DOUBLE] [-u] [-w] [-o FILE] [-s INT] [-l] [-y] [-e DOUBLE] [-x] [-v]\n\n");
   printf("-flag : <description> (= <default value>)\n");
   printf("-a : SLS algorithm (= WalkSAT) \n");
   printf("    WalkSAT (0) \n");
@@ -566,52 +1061,66 @@ void printUsageError() {
   printf("-c : UCT exploration/exploitation parameter (=0.02) \n");
   printf("-m : max flips for each sls run (=500) \n");
   printf("-n : noise param for each sls run (=0.0) \n");
-  printf("-t : run timeout in seconds (NA). Iterations should be set accordingly \n\n");
+  printf("-t : run timeout in seconds, fractions allowed (NA). Iterations should be set accordingly \n");
+  printf("-u : measure the run timeout in process cpu time instead of wall time (wall time) \n");
+  printf("-w : weighted and partial MaxSAT, minimize the weight of the unsat clauses of a .wcnf file, whose hard clauses must be sat (off) \n");
+  printf("-s : random seed, untimed runs with the same seed give the same results (time based) \n");
+  printf("-l : use the legacy Mersenne Twister generator with modulo sampling (xoshiro256**) \n");
+  printf("-y : print the anytime profile of each run, every improvement with its time (off) \n");
+  printf("-e : seconds between reports of the UCT counters, builds with -DUCT_STATS only (off) \n");
+  printf("-x : count cycles, instructions, cache and branch misses of each UCT phase with perf_event, builds with -DUCT_STATS only (off) \n");
+  printf("-o : write one JSON object per run to the given file, CSV rows if its name ends in .csv (off) \n");
+  printf("-v : add the best assignment of each run to its -o record (off) \n\n");
   fflush(stdout);
   exit(1);
 }
 
 
-/* Performs a single untimed UCT run and returns the best number of unsat clauses found */
-int runUCT() {
+/* Performs a single untimed UCT run and returns the best cost found */
+double runUCT() {
   int i;
   depthLimit = iNumVars-1;
   
   bestReward=MIN_REWARD;
   
-  clockStopped = FALSE;
-  start = clock();
   /* all variables begin as mutable */
   setMutable();
   /* free the previous tree from memory and initialize a new root node */
   if (root) {
     freeNode(root);
   }
+  STATS(peakTreeBytes = treeBytes);
   setRootNode();
   for (i=0; i<numIterations; i++) {
+    // the closed arms of a closed tree lead to nodes without an atom
+    if (root->closed[LEFT] && root->closed[RIGHT]) break;
+    STATS(double start = DeadlineClock(FALSE));
+    iterationNum = i+1;
     setMutable();
     playNode(root); 
+    STATS(
+      stats.iterationTime += DeadlineClock(FALSE)-start;
+      hwSample(HW_DESCENT);
+      if (statsInterval>0) reportStats();
+    )
   }
   fflush(stdout);
   
+  if (weighted) return runCostW();
   return getNumUnsat(bestReward);
 }
 
-/* Performs a single timed UCT run and returns the best number of unsat clauses found */
-int runUCTtimed() {
+/* Performs a single timed UCT run and returns the best cost found */
+double runUCTtimed() {
   int i=0;
   
   depthLimit = iNumVars-1;
   bestReward=MIN_REWARD;
   iterationNum = 0;
   
-  // Install the timeout handler and set the alarm
-  signal(SIGALRM, ALARMhandler);
   timeFlag = TRUE;
-  alarm(runTimeout);
+  SetDeadline(runTimeout, cpuTimeout);
   
-  clockStopped=FALSE;
-  start = clock();
   
   // All variables begin as mutable
   setMutable();
@@ -619,36 +1128,39 @@ int runUCTtimed() {
   // Free the previous tree from memory and initialize a new root node
   if (root)
     freeNode(root);
+  STATS(peakTreeBytes = treeBytes);
   setRootNode();
   
-  while (timeFlag) {
+  while (timeFlag && !DeadlinePassed()) {
+    // the closed arms of a closed tree lead to nodes without an atom
+    if (root->closed[LEFT] && root->closed[RIGHT]) break;
+    STATS(double start = DeadlineClock(FALSE));
     iterationNum++;
     setMutable();
     playNode(root); 
+    STATS(
+      stats.iterationTime += DeadlineClock(FALSE)-start;
+      hwSample(HW_DESCENT);
+      if (statsInterval>0) reportStats();
+    )
     if (++i == numIterations) {
       printf("Fatal Error: increase number of iterations!\n");
       fflush(stdout);
       exit(1);
     }
   }
+  bestRewardAtTimeout = bestReward;
+  ClearDeadline();
   
+  if (weighted) return runCostW();
   return getNumUnsat(bestRewardAtTimeout);
 }
 
 
-/* Handles timeout signals */
-void  ALARMhandler(int sig)
-{
-  bestRewardAtTimeout = bestReward;
-  timeFlag = FALSE;
-  signal(SIGALRM, SIG_IGN);
-}
-
-
 /* Performs UCT runs and prints the results to stdout */
 void performRuns() {
   int i,j;
-  int numUnsat[numRuns];
+  double cost[numRuns];
   
   if (iNumVars>MAX_NUM_VARS || iNumClauses>MAX_NUM_CLAUSES) {
     printf("Fatal Error: increase size of MAX_NUM_VARS or MAX_NUM_CLAUSES\n");
@@ -657,16 +1169,39 @@ void performRuns() {
   }
   
   setAlwaysSat();
+  if (weighted) setHardClauses();
+  
+  profiles = (trajectorypoint**) calloc(numRuns, sizeof(trajectorypoint*));
+  profileLen = (int*) calloc(numRuns, sizeof(int));
   
   for (i=0; i<numRuns; i++) { 
     for (j=1; j<=iNumVars; j++) {
       bestSoln[j]=RandomInt(2);
     }
     runBestNumFalse = MAX_NUM_CLAUSES+1;
+    runNum = i;
+    runStart = DeadlineClock(FALSE);
+    treeNodes = 0;
+    maxDepth = 0;
+    runFlips = 0;
+    trajectoryBest = weighted ? fTotalWeight+1 : MAX_NUM_CLAUSES+1;
+    STATS(
+      memset(&stats, 0, sizeof(stats));
+      nextStatsReport = runStart + statsInterval;
+      if (hwEnabled) hwStart();
+    )
     if (timed) {
-      numUnsat[i] = runUCTtimed(); 
+      cost[i] = runUCTtimed(); 
+    }
+    else cost[i] = runUCT();
+    STATS(
+      char label[32];
+      sprintf(label, "Stats run %d", i);
+      printStats(label, DeadlineClock(FALSE) - runStart);
+    )
+    if (resultsFile) {
+      writeResult(i, cost[i]);
     }
-    else numUnsat[i] = runUCT();
   }
   
   ubcsatcleanup();
@@ -674,9 +1209,19 @@ void performRuns() {
   // print results to stdout
   printf("\n*** Best Num Unsat ***\n");
   for (i=0; i<numRuns; i++) {
-    printf("Run %d: %d\n", i, numUnsat[i]);
+    printf("Run %d: %.12g\n", i, cost[i]);
   }
   printf("\n");
+  if (printTrajectory) {
+    printf("*** Anytime Profile (time iteration nodes flips %s) ***\n", weighted ? "cost" : "unsat");
+    for (i=0; i<numRuns; i++) {
+      for (j=0; j<profileLen[i]; j++) {
+        printf("Run %d: %f %d %d %lu %.12g\n", i, profiles[i][j].time, profiles[i][j].iteration,
+               profiles[i][j].nodes, (unsigned long) profiles[i][j].flips, profiles[i][j].cost);
+      }
+    }
+    printf("\n");
+  }
   printf("Total Time Elapsed: %f\n\n", fTotalTime);
   printParams();
 }
@@ -685,7 +1230,7 @@ void performRuns() {
 
 #define COMMAND_LN_LEN 300
 #define MAX_ARG_LEN 30
-#define MAX_NUM_ARGS 20
+#define MAX_NUM_ARGS 24
 
 /* Mostly command line parsing here */
 int main(int argc, char **argv) {
@@ -696,13 +1241,14 @@ int main(int argc, char **argv) {
   char runsstr[MAX_ARG_LEN];
   char cutoffstr[MAX_ARG_LEN];
   char noisestr[MAX_ARG_LEN];
+  char seedstr[MAX_ARG_LEN];
   
   int ubcargc;
   char **ubcargv;
   char ubccommandline[COMMAND_LN_LEN];
   char *token;
   
-  while ((option = getopt(argc, argv, "f:c:i:m:r:n:a:t:")) != -1) {
+  while ((option = getopt(argc, argv, "f:c:i:m:r:n:a:t:uws:lye:o:vx")) != -1) {
     
     switch (option) {
     
@@ -743,9 +1289,53 @@ int main(int argc, char **argv) {
       break;
       
     case 't':
-      runTimeout = atoi(optarg);
+      runTimeout = atof(optarg);
       timed = TRUE;
       break;
+      
+    case 'u':
+      cpuTimeout = TRUE;
+      break;
+      
+    case 'w':
+      weighted = TRUE;
+      break;
+      
+    case 'y':
+      printTrajectory = TRUE;
+      break;
+      
+    case 'l':
+      legacyRandom = TRUE;
+      break;
+      
+    case 'e':
+      statsInterval = atof(optarg);
+      break;
+      
+    case 'o':
+      resultsFile = fopen(optarg, "w");
+      if (!resultsFile) {
+        printf("Fatal Error: cannot open results file %s!\n", optarg);
+        fflush(stdout);
+        exit(1);
+      }
+      setvbuf(resultsFile, NULL, _IOFBF, RESULTS_BUFFER);
+      resultsCsv = strlen(optarg)>=4 && strcmp(optarg+strlen(optarg)-4, ".csv")==0;
+      break;
+      
+    case 'v':
+      printModel = TRUE;
+      break;
+      
+    case 'x':
+      hwEnabled = TRUE;
+      break;
+      
+    case 's':
+      masterSeed = strtoul(optarg, NULL, 10);
+      seeded = TRUE;
+      break;
     	
     case '?':
       if (optopt == 'c')
@@ -771,7 +1361,7 @@ int main(int argc, char **argv) {
   
   ubcargv = (char**)malloc(MAX_NUM_ARGS*sizeof(char*));
   for (i=0; i<MAX_NUM_ARGS; i++) {
-    ubcargv[i] = malloc(MAX_NUM_ARGS*sizeof(char));
+    ubcargv[i] = malloc(COMMAND_LN_LEN*sizeof(char));
   }
   
   strcpy(ubccommandline, "./ubcsat -alg ");
@@ -798,6 +1388,18 @@ int main(int argc, char **argv) {
   strcat(ubccommandline, "-i ");
   strcat(ubccommandline, filename);
 
+  
+  if (seeded) {
+    sprintf(seedstr, " -seed %lu", (unsigned long) masterSeed);
+    strcat(ubccommandline, seedstr);
+  }
+
+  if (legacyRandom)
+    strcat(ubccommandline, " -legacyrand");
+
+  if (weighted)
+    strcat(ubccommandline, " -w");
+
   strcat(ubccommandline, " -r stats null -r out null ");
   
   token = strtok(ubccommandline, " ");
@@ -815,6 +1417,9 @@ int main(int argc, char **argv) {
   ubcsatsetup(ubcargc,ubcargv);
   
   performRuns();
+  if (resultsFile) {
+    fclose(resultsFile);
+  }
 
   return 0;
 }
\ No newline at end of file
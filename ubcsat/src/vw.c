@@ -22,8 +22,8 @@
 
 #include "ubcsat.h"
 
-FLOAT fVW2Smooth;
-FLOAT fVW2WeightFactor;
+THREADLOCAL FLOAT fVW2Smooth;
+THREADLOCAL FLOAT fVW2WeightFactor;
 void PickVW1();
 void PickVW2();
 
@@ -33,8 +33,8 @@ void CreateVW2Weights();
 void InitVW2Weights();
 void UpdateVW2Weights();
 
-FLOAT *aVW2Weights;
-FLOAT fVW2WeightMean;
+THREADLOCAL FLOAT *aVW2Weights;
+THREADLOCAL FLOAT fVW2WeightMean;
 
 
 void AddVW() {
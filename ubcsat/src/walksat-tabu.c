@@ -55,7 +55,7 @@ void AddWalkSatTabu() {
 
 }
 
-UINT32 iWalkSATTabuClause;
+THREADLOCAL UINT32 iWalkSATTabuClause;
 
 void PickWalkSatTabu()
 {